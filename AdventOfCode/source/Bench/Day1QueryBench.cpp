@@ -0,0 +1,118 @@
+#include "Common/Benchmark.hh"
+#include "Common/Resources.hh"
+#include "Common/ThreadPool.hh"
+#include "Day1/ExpenseIndex.hh"
+
+#include <cstdint>
+#include <cstdlib>
+
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <random>
+#include <vector>
+
+// Throughput of Day1::ExpenseIndex answering batches of target sums, on one thread and on
+// the shared pool, against running findSum from scratch for every target.
+
+namespace
+{
+
+using Day1::Value;
+using Day1::Values;
+
+struct Workload
+{
+    const char* name;
+    std::size_t k;
+    std::size_t entries;
+    std::size_t queries;
+};
+
+Values generateEntries(std::size_t count, std::mt19937_64& random)
+{
+    Values entries(count);
+    for(Value& entry : entries)
+    {
+        entry = static_cast<Value>(random() % 1'000'000) + 1;
+    }
+    return entries;
+}
+
+// Every other target is a sum of k entries by construction, the rest are drawn from the
+// range of such sums.
+Values generateTargets(const Values& entries, std::size_t k, std::size_t count, std::mt19937_64& random)
+{
+    Values targets(count);
+    for(std::size_t i = 0; i < count; ++i)
+    {
+        Value sum = 0;
+        for(std::size_t j = 0; j < k; ++j)
+        {
+            sum += i % 2 == 0 ? entries[random() % entries.size()] : static_cast<Value>(random() % 1'000'000) + 1;
+        }
+        targets[i] = sum;
+    }
+    return targets;
+}
+
+std::size_t countFound(const std::vector<std::optional<Values>>& results)
+{
+    std::size_t count = 0;
+    for(const auto& result : results)
+    {
+        count += result.has_value();
+    }
+    return count;
+}
+
+}
+
+int main(int argc, char* argv[])
+{
+    const std::size_t scale = argc > 1 ? static_cast<std::size_t>(std::atoi(argv[1])) : 1;
+    const std::vector<Workload> workloads{
+        {"pairs", 2, 100'000 * scale, 10'000 * scale},
+        {"triples", 3, 2'000 * scale, 1'000 * scale},
+    };
+    std::mt19937_64 random{2020};
+    Common::ThreadPool& pool = Common::ThreadPool::instance();
+
+    Common::MethodComparison<std::size_t> comparison{std::cout};
+    std::cout << std::fixed << std::setprecision(3);
+    for(const Workload& workload : workloads)
+    {
+        const Values entries = generateEntries(workload.entries, random);
+        const Values targets = generateTargets(entries, workload.k, workload.queries, random);
+        std::cout << workload.name << ": " << workload.entries << " entries, " << workload.queries << " targets\n";
+        comparison.startWorkload({{static_cast<double>(workload.queries), "queries/s"}});
+
+        comparison.run("findSum per target", [&]()
+        {
+            std::size_t found = 0;
+            for(Value target : targets)
+            {
+                found += Day1::findSum(entries, target, workload.k).has_value();
+            }
+            return found;
+        });
+
+        Common::Stopwatch buildStopwatch;
+        const Day1::ExpenseIndex index{entries};
+        const double build = buildStopwatch.getSeconds();
+        const std::size_t targetsFound = comparison.run("index, one thread", [&]()
+        {
+            std::size_t found = 0;
+            for(Value target : targets)
+            {
+                found += index.find(target, workload.k).has_value();
+            }
+            return found;
+        });
+        comparison.run("index, batch on the pool", [&]() { return countFound(index.findAll(targets, workload.k, pool)); });
+
+        std::cout << "  index built in " << build * 1000.0 << " ms, " << pool.getNumThreads()
+            << " pool threads, " << targetsFound << " targets found\n";
+    }
+    return comparison.getExitCode();
+}
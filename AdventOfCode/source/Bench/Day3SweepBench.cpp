@@ -0,0 +1,73 @@
+#include "Common/Benchmark.hh"
+#include "Common/ThreadPool.hh"
+#include "Day3/SlopeSweep.hh"
+#include "Generator/Generator.hh"
+
+#include <cstdint>
+#include <cstdlib>
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Every slope up to a bound on generated maps from the puzzle's 31 columns to very wide ones:
+// Day3::sweepSlopes on the shared pool against one countTrees pass over all of the slopes.
+
+namespace
+{
+
+struct Workload
+{
+    std::size_t rows;
+    std::size_t columns;
+    Day3::Coord maxSlope;
+};
+
+std::vector<Day3::Coord> getAllSlopes(const Day3::Coord& maxSlope)
+{
+    std::vector<Day3::Coord> slopes;
+    for(int down = 1; down <= maxSlope.down; ++down)
+    {
+        for(int right = 0; right <= maxSlope.right; ++right)
+        {
+            slopes.push_back({right, down});
+        }
+    }
+    return slopes;
+}
+
+}
+
+int main(int argc, char* argv[])
+{
+    const std::size_t scale = argc > 1 ? static_cast<std::size_t>(std::atoi(argv[1])) : 1;
+    const std::vector<Workload> workloads{
+        {1'000'000 * scale, 31, {31, 8}},
+        {20'000 * scale, 4096, {64, 16}},
+        {2'000 * scale, 65536, {64, 16}},
+    };
+    Common::ThreadPool& pool = Common::ThreadPool::instance();
+
+    Common::MethodComparison<std::vector<std::uint64_t>> comparison{std::cout};
+    for(const Workload& workload : workloads)
+    {
+        const Day3::TreeMap map = Day3::TreeMap::load(Generator::generateTreeMap(workload.rows, workload.columns, 3));
+        const std::vector<Day3::Coord> slopes = getAllSlopes(workload.maxSlope);
+        std::cout << workload.rows << " x " << workload.columns << " map, " << slopes.size() << " slopes\n";
+        comparison.startWorkload({{static_cast<double>(workload.rows) * static_cast<double>(slopes.size()) / 1e6, "M slope-rows/s"}});
+
+        const std::vector<std::uint64_t> counts = comparison.run("countTrees, one pass", [&]() { return Day3::countTrees(map, slopes); });
+        const Day3::SlopeSweep sweep = comparison.time("sweepSlopes on the pool", [&]() { return Day3::sweepSlopes(map, workload.maxSlope, pool); });
+
+        bool consistent = true;
+        for(std::size_t i = 0; i < slopes.size(); ++i)
+        {
+            consistent = consistent && sweep.getTrees(slopes[i]) == counts[i];
+        }
+        comparison.expect(consistent, "sweepSlopes on the pool");
+        std::cout << "  fewest trees at " << sweep.fewestTrees.right << "," << sweep.fewestTrees.down << " ("
+            << sweep.getTrees(sweep.fewestTrees) << "), most at " << sweep.mostTrees.right << "," << sweep.mostTrees.down
+            << " (" << sweep.getTrees(sweep.mostTrees) << "), " << pool.getNumThreads() << " pool threads\n";
+    }
+    return comparison.getExitCode();
+}
@@ -0,0 +1,44 @@
+#include "Common/Benchmark.hh"
+#include "Day4/Passports.hh"
+#include "Day4/Validators.hh"
+#include "Generator/Generator.hh"
+
+#include <cstdint>
+#include <cstdlib>
+
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+// Passports validated per second on a generated batch file: one passport at a time through
+// PassportTable::isValid against the branch-free batches of Day4::countValidScalar and the
+// AVX2 ones of Day4::countValidSimd.
+
+int main(int argc, char* argv[])
+{
+    const std::size_t count = argc > 1 ? static_cast<std::size_t>(std::atoll(argv[1])) : 2'000'000;
+    const std::string input = Generator::generate(4, count, 4);
+
+    Common::Stopwatch parseStopwatch;
+    const Day4::PassportTable passports = Day4::PassportTable::parse(input);
+    const double parse = parseStopwatch.getSeconds();
+
+    std::cout << std::fixed << std::setprecision(1) << passports.size() << " passports, "
+        << static_cast<double>(input.size()) / (1024.0 * 1024.0) << " MiB, parsed in " << parse * 1000.0 << " ms\n";
+    Common::MethodComparison<std::uint64_t> comparison{std::cout};
+    comparison.startWorkload({{static_cast<double>(passports.size()) / 1e6, "M passports/s"}});
+    comparison.run("isValid, one passport at a time", [&]()
+    {
+        std::uint64_t valid = 0;
+        for(std::size_t passport = 0; passport < passports.size(); ++passport)
+        {
+            valid += passports.isValid(passport);
+        }
+        return valid;
+    });
+    comparison.run("countValidScalar, batches", [&]() { return Day4::countValidScalar(passports); });
+    const std::uint64_t valid = comparison.run(Day4::hasSimdPassportValidator() ? "countValidSimd (avx2)" : "countValidSimd (scalar fallback)",
+        [&]() { return Day4::countValidSimd(passports); });
+    std::cout << "  " << valid << " valid\n";
+    return comparison.getExitCode();
+}
@@ -0,0 +1,75 @@
+#include "Common/Benchmark.hh"
+#include "Day5/Seats.hh"
+
+#include <cstdint>
+#include <cstdlib>
+
+#include <array>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Boarding passes decoded per second from a synthetic manifest, 100M passes by default: the
+// scalar and the AVX2 bulk decoders into a preallocated buffer, and Day5::SeatMap::decode.
+
+namespace
+{
+
+std::string makeManifest(std::size_t count)
+{
+    std::array<std::string, Day5::NUM_SEATS> passes;
+    for(std::size_t seat = 0; seat < passes.size(); ++seat)
+    {
+        for(std::size_t bit = Day5::PASS_LENGTH; bit-- > 0;)
+        {
+            const bool one = (seat >> bit) & 1;
+            passes[seat] += bit >= 3 ? (one ? 'B' : 'F') : (one ? 'R' : 'L');
+        }
+        passes[seat] += '\n';
+    }
+    std::mt19937_64 random{5};
+    std::string manifest;
+    manifest.reserve(count * (Day5::PASS_LENGTH + 1));
+    for(std::size_t i = 0; i < count; ++i)
+    {
+        manifest += passes[random() % passes.size()];
+    }
+    return manifest;
+}
+
+}
+
+int main(int argc, char* argv[])
+{
+    const std::size_t count = argc > 1 ? static_cast<std::size_t>(std::atoll(argv[1])) : 100'000'000;
+    const std::string manifest = makeManifest(count);
+    std::cout << std::fixed << std::setprecision(1) << count << " passes, "
+        << static_cast<double>(manifest.size()) / (1024.0 * 1024.0) << " MiB\n";
+
+    // The buffers are allocated up front and moved out, so only the decoding is timed.
+    std::vector<Day5::SeatId> scalar(Day5::getMaxSeatCount(manifest));
+    std::vector<Day5::SeatId> simd(Day5::getMaxSeatCount(manifest));
+    Common::MethodComparison<std::vector<Day5::SeatId>> comparison{std::cout};
+    comparison.startWorkload({
+        {static_cast<double>(count) / 1e6, "M passes/s"},
+        {static_cast<double>(manifest.size()) / (1024.0 * 1024.0 * 1024.0), "GiB/s"},
+    });
+    const std::size_t decoded = comparison.run("decodeSeatsScalar", [&]()
+    {
+        scalar.resize(Day5::decodeSeatsScalar(manifest, scalar.data()));
+        return std::move(scalar);
+    }).size();
+    comparison.expect(decoded == count, "decodeSeatsScalar");
+    comparison.run(Day5::hasSimdSeatDecoder() ? "decodeSeatsSimd (avx2)" : "decodeSeatsSimd (scalar fallback)", [&]()
+    {
+        simd.resize(Day5::decodeSeatsSimd(manifest, simd.data()));
+        return std::move(simd);
+    });
+    const Day5::SeatMap map = comparison.time("SeatMap::decode", [&]() { return Day5::SeatMap::decode(manifest); });
+    comparison.expect(map.getNumPasses() == count, "SeatMap::decode");
+    std::cout << "  highest seat " << map.getHighest().value_or(0) << "\n";
+    return comparison.getExitCode();
+}
@@ -0,0 +1,123 @@
+#include "Common/Parse.hh"
+#include "Common/Resources.hh"
+
+#include <cstdint>
+#include <cstdlib>
+
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Compares the shared integer parsers against the stream based loaders they replaced
+// (operator>> as in Day9::loadNumbers, getline + stoll as in Day16::Ticket::load).
+
+namespace
+{
+
+using Numbers = std::vector<std::uint64_t>;
+
+struct Input
+{
+    std::string name;
+    std::string text;
+    std::size_t count = 0;
+};
+
+Input generate(const std::string& name, std::size_t bytes, std::uint64_t maxValue, char separator, std::uint64_t seed)
+{
+    std::mt19937_64 random{seed};
+    std::uniform_int_distribution<std::uint64_t> distribution{0, maxValue};
+    Input input{name, {}, 0};
+    input.text.reserve(bytes + 32);
+    while(input.text.size() < bytes)
+    {
+        input.text += std::to_string(distribution(random));
+        input.text += separator;
+        ++input.count;
+    }
+    return input;
+}
+
+struct Method
+{
+    std::string name;
+    std::function<std::size_t(const std::string& text, Numbers& out)> parse;
+};
+
+std::size_t parseStream(const std::string& text, Numbers& out)
+{
+    std::istringstream stream{text};
+    std::size_t count = 0;
+    for(std::uint64_t value = 0; stream >> value; stream.ignore(1))
+    {
+        out[count++] = value;
+    }
+    return count;
+}
+
+std::size_t parseGetlineStoll(const std::string& text, Numbers& out)
+{
+    std::istringstream stream{text};
+    std::size_t count = 0;
+    const char separator = text.find(',') != std::string::npos ? ',' : '\n';
+    for(std::string value; std::getline(stream, value, separator);)
+    {
+        out[count++] = std::stoull(value);
+    }
+    return count;
+}
+
+}
+
+int main(int argc, char* argv[])
+{
+    const std::size_t megabytes = argc > 1 ? static_cast<std::size_t>(std::atoi(argv[1])) : 16;
+    const std::size_t bytes = megabytes * 1024 * 1024;
+    constexpr int REPETITIONS = 5;
+
+    const std::vector<Input> inputs{
+        generate("expenses, 4 digits, lines", bytes, 2020, '\n', 1),
+        generate("tickets, 3 digits, commas", bytes, 999, ',', 2),
+        generate("xmas, up to 15 digits, lines", bytes, 999'999'999'999'999, '\n', 3),
+    };
+    const std::vector<Method> methods{
+        {"istream >>", parseStream},
+        {"getline + stoull", parseGetlineStoll},
+        {"scalar", [](const std::string& text, Numbers& out) { return Common::parseNumbersScalar(text, out.data()); }},
+        {Common::hasSimdNumberParser() ? "sse4.1" : "simd (scalar fallback)", [](const std::string& text, Numbers& out) { return Common::parseNumbersSimd(text, out.data()); }},
+    };
+
+    bool allCorrect = true;
+    std::cout << std::fixed << std::setprecision(1);
+    for(const Input& input : inputs)
+    {
+        std::cout << input.name << ": " << input.text.size() / (1024.0 * 1024.0) << " MiB, " << input.count << " numbers\n";
+        Numbers reference(Common::getMaxNumberCount(input.text));
+        reference.resize(Common::parseNumbersScalar(input.text, reference.data()));
+        for(const Method& method : methods)
+        {
+            Numbers out(Common::getMaxNumberCount(input.text));
+            double best = 0.0;
+            std::size_t count = 0;
+            for(int i = 0; i < REPETITIONS; ++i)
+            {
+                Common::Stopwatch stopwatch;
+                count = method.parse(input.text, out);
+                double seconds = stopwatch.getSeconds();
+                best = i == 0 ? seconds : std::min(best, seconds);
+            }
+            out.resize(count);
+            const bool correct = out == reference && count == input.count;
+            allCorrect = allCorrect && correct;
+            std::cout << "  " << std::left << std::setw(24) << method.name << std::right
+                << std::setw(10) << input.text.size() / best / (1024.0 * 1024.0) << " MiB/s"
+                << std::setw(10) << count / best / 1e6 << " M numbers/s"
+                << (correct ? "" : "  WRONG RESULT") << "\n";
+        }
+    }
+    return allCorrect ? EXIT_SUCCESS : EXIT_FAILURE;
+}
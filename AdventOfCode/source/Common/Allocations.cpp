@@ -0,0 +1,213 @@
+#include "Allocations.hh"
+
+#include <cstdlib>
+
+#include <algorithm>
+#include <atomic>
+#include <new>
+
+#if AOC_TRACK_ALLOCATIONS
+#if defined(_WIN32)
+#include <malloc.h>
+#elif defined(__APPLE__)
+#include <malloc/malloc.h>
+#else
+#include <malloc.h>
+#endif
+#endif
+
+namespace Common
+{
+
+namespace
+{
+
+// constant initialised, so it is usable from operator new at any time
+struct Heap
+{
+    std::uint64_t count;
+    std::uint64_t bytes;
+    std::int64_t liveBytes;
+    std::int64_t peakLiveBytes;
+};
+
+thread_local Heap heap{};
+
+}
+
+// Written by the threads that charge work to this one, so unlike Heap it is atomic.
+struct AllocationOwner
+{
+    std::atomic<std::uint64_t> count;
+    std::atomic<std::uint64_t> bytes;
+    std::atomic<std::int64_t> peakLiveBytes;   // largest single charge since the innermost scope began
+};
+
+namespace
+{
+
+thread_local AllocationOwner owner{};
+
+}
+
+AllocationScope::AllocationScope()
+    : count{heap.count}
+    , bytes{heap.bytes}
+    , liveBytes{heap.liveBytes}
+    , outerPeakLiveBytes{heap.peakLiveBytes}
+    , chargedCount{owner.count.load(std::memory_order_relaxed)}
+    , chargedBytes{owner.bytes.load(std::memory_order_relaxed)}
+    , outerChargedPeakLiveBytes{owner.peakLiveBytes.exchange(0, std::memory_order_relaxed)}
+{
+    heap.peakLiveBytes = heap.liveBytes;
+}
+
+AllocationStats AllocationScope::stop()
+{
+    AllocationStats result;
+    if(stopped)
+    {
+        return result;
+    }
+    stopped = true;
+    const std::int64_t chargedPeakLiveBytes = owner.peakLiveBytes.load(std::memory_order_relaxed);
+    result.count = heap.count - count + owner.count.load(std::memory_order_relaxed) - chargedCount;
+    result.bytes = heap.bytes - bytes + owner.bytes.load(std::memory_order_relaxed) - chargedBytes;
+    result.peakLiveBytes = heap.peakLiveBytes - liveBytes + chargedPeakLiveBytes;
+    heap.peakLiveBytes = std::max(heap.peakLiveBytes, outerPeakLiveBytes);
+    owner.peakLiveBytes.store(std::max(chargedPeakLiveBytes, outerChargedPeakLiveBytes), std::memory_order_relaxed);
+    return result;
+}
+
+AllocationOwner* getAllocationOwner()
+{
+    return &owner;
+}
+
+void chargeAllocations(AllocationOwner* target, const AllocationStats& stats)
+{
+    target->count.fetch_add(stats.count, std::memory_order_relaxed);
+    target->bytes.fetch_add(stats.bytes, std::memory_order_relaxed);
+    std::int64_t peak = target->peakLiveBytes.load(std::memory_order_relaxed);
+    while(peak < stats.peakLiveBytes && target->peakLiveBytes.compare_exchange_weak(peak, stats.peakLiveBytes, std::memory_order_relaxed) == false)
+    {
+    }
+}
+
+}
+
+#if AOC_TRACK_ALLOCATIONS
+
+namespace
+{
+
+std::size_t getUsableSize(void* pointer)
+{
+#if defined(_WIN32)
+    return _msize(pointer);
+#elif defined(__APPLE__)
+    return malloc_size(pointer);
+#else
+    return malloc_usable_size(pointer);
+#endif
+}
+
+void* track(void* pointer, std::size_t size)
+{
+    if(pointer != nullptr)
+    {
+        auto& heap = Common::heap;
+        ++heap.count;
+        heap.bytes += size;
+        heap.liveBytes += static_cast<std::int64_t>(getUsableSize(pointer));
+        heap.peakLiveBytes = std::max(heap.peakLiveBytes, heap.liveBytes);
+    }
+    return pointer;
+}
+
+void* allocate(std::size_t size, const std::nothrow_t&) noexcept
+{
+    return track(std::malloc(size == 0 ? 1 : size), size);
+}
+
+void* allocate(std::size_t size)
+{
+    void* pointer = allocate(size, std::nothrow);
+    if(pointer == nullptr)
+    {
+        throw std::bad_alloc{};
+    }
+    return pointer;
+}
+
+void* allocateAligned(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    const auto align = static_cast<std::size_t>(alignment);
+    size = size == 0 ? align : (size + align - 1) / align * align;
+#if defined(_WIN32)
+    // _aligned_malloc memory has no _msize, count it as allocated but not live
+    void* pointer = _aligned_malloc(size, align);
+    if(pointer != nullptr)
+    {
+        ++Common::heap.count;
+        Common::heap.bytes += size;
+    }
+    return pointer;
+#else
+    return track(std::aligned_alloc(align, size), size);
+#endif
+}
+
+void* allocateAligned(std::size_t size, std::align_val_t alignment)
+{
+    void* pointer = allocateAligned(size, alignment, std::nothrow);
+    if(pointer == nullptr)
+    {
+        throw std::bad_alloc{};
+    }
+    return pointer;
+}
+
+void release(void* pointer) noexcept
+{
+    if(pointer != nullptr)
+    {
+        Common::heap.liveBytes -= static_cast<std::int64_t>(getUsableSize(pointer));
+        std::free(pointer);
+    }
+}
+
+void releaseAligned(void* pointer) noexcept
+{
+#if defined(_WIN32)
+    _aligned_free(pointer);
+#else
+    release(pointer);
+#endif
+}
+
+}
+
+void* operator new(std::size_t size) { return allocate(size); }
+void* operator new[](std::size_t size) { return allocate(size); }
+void* operator new(std::size_t size, const std::nothrow_t& tag) noexcept { return allocate(size, tag); }
+void* operator new[](std::size_t size, const std::nothrow_t& tag) noexcept { return allocate(size, tag); }
+void* operator new(std::size_t size, std::align_val_t alignment) { return allocateAligned(size, alignment); }
+void* operator new[](std::size_t size, std::align_val_t alignment) { return allocateAligned(size, alignment); }
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t& tag) noexcept { return allocateAligned(size, alignment, tag); }
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t& tag) noexcept { return allocateAligned(size, alignment, tag); }
+
+void operator delete(void* pointer) noexcept { release(pointer); }
+void operator delete[](void* pointer) noexcept { release(pointer); }
+void operator delete(void* pointer, std::size_t) noexcept { release(pointer); }
+void operator delete[](void* pointer, std::size_t) noexcept { release(pointer); }
+void operator delete(void* pointer, const std::nothrow_t&) noexcept { release(pointer); }
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept { release(pointer); }
+void operator delete(void* pointer, std::align_val_t) noexcept { releaseAligned(pointer); }
+void operator delete[](void* pointer, std::align_val_t) noexcept { releaseAligned(pointer); }
+void operator delete(void* pointer, std::size_t, std::align_val_t) noexcept { releaseAligned(pointer); }
+void operator delete[](void* pointer, std::size_t, std::align_val_t) noexcept { releaseAligned(pointer); }
+void operator delete(void* pointer, std::align_val_t, const std::nothrow_t&) noexcept { releaseAligned(pointer); }
+void operator delete[](void* pointer, std::align_val_t, const std::nothrow_t&) noexcept { releaseAligned(pointer); }
+
+#endif
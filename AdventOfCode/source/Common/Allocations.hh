@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstdint>
+
+#ifndef AOC_TRACK_ALLOCATIONS
+#define AOC_TRACK_ALLOCATIONS 0
+#endif
+
+namespace Common
+{
+
+// Heap traffic of the calling thread, counted by the replacements of the global operator
+// new and delete that are compiled in with -DAOC_TRACK_ALLOCATIONS=ON, plus that of the
+// work it handed to other threads (see chargeAllocations). Memory freed by another thread
+// than the one that allocated it skews the live bytes of both.
+struct AllocationStats
+{
+    bool isEmpty() const { return count == 0 && peakLiveBytes == 0; }
+
+    std::uint64_t count = 0;
+    std::uint64_t bytes = 0;            // as requested
+    std::int64_t peakLiveBytes = 0;     // above the live bytes at the start of the measurement
+};
+
+constexpr bool isTrackingAllocations() { return AOC_TRACK_ALLOCATIONS != 0; }
+
+// Measures the allocations of the calling thread from construction until stop(), including
+// those charged to it by other threads meanwhile. Scopes nest: an outer scope still sees
+// the peak reached inside an inner one.
+struct AllocationScope
+{
+public:
+    AllocationScope();
+    AllocationStats stop();
+
+private:
+    std::uint64_t count = 0;
+    std::uint64_t bytes = 0;
+    std::int64_t liveBytes = 0;
+    std::int64_t outerPeakLiveBytes = 0;
+    std::uint64_t chargedCount = 0;
+    std::uint64_t chargedBytes = 0;
+    std::int64_t outerChargedPeakLiveBytes = 0;
+    bool stopped = false;
+};
+
+// The counters of a thread that work run elsewhere, e.g. a ThreadPool task, is charged to.
+// Charged counts and bytes add up; the peak of a scope grows by the largest peak of a
+// single charged piece of work, as their overlap in time is not known.
+struct AllocationOwner;
+AllocationOwner* getAllocationOwner();
+void chargeAllocations(AllocationOwner* owner, const AllocationStats& stats);
+
+// Calls func, and when the calling thread is not owner, charges its heap traffic to owner
+// before returning, so whoever waits for the result already sees it.
+template<typename Func>
+decltype(auto) runChargedTo(AllocationOwner* owner, Func& func)
+{
+    if constexpr(isTrackingAllocations())
+    {
+        if(owner != getAllocationOwner())
+        {
+            struct Charge
+            {
+                ~Charge() { chargeAllocations(owner, scope.stop()); }
+
+                AllocationOwner* owner;
+                AllocationScope scope;
+            } charge{owner, {}};
+            return func();
+        }
+    }
+    return func();
+}
+
+}
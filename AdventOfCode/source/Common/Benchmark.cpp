@@ -0,0 +1,251 @@
+#include "Benchmark.hh"
+
+#include "Json.hh"
+#include "Trace.hh"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <exception>
+#include <iomanip>
+#include <numeric>
+#include <ostream>
+
+namespace Common
+{
+
+namespace
+{
+
+using Clock = std::chrono::steady_clock;
+
+struct ParseMark
+{
+    Clock::time_point time;
+    std::size_t items = 0;
+    bool isSet = false;
+};
+
+thread_local ParseMark* currentMark = nullptr;
+
+double toSeconds(Clock::duration duration)
+{
+    return std::chrono::duration<double>(duration).count();
+}
+
+void writeJson(std::ostream& stream, const Statistics& statistics)
+{
+    stream << "{\"min\": " << statistics.min << ", \"median\": " << statistics.median
+        << ", \"p99\": " << statistics.p99 << ", \"mean\": " << statistics.mean << "}";
+}
+
+}
+
+void markParsed(std::size_t items)
+{
+    if(currentMark != nullptr && currentMark->isSet == false)
+    {
+        currentMark->time = Clock::now();
+        currentMark->items = items;
+        currentMark->isSet = true;
+    }
+}
+
+Statistics Statistics::compute(std::vector<double> samples)
+{
+    Statistics result;
+    if(samples.empty())
+    {
+        return result;
+    }
+    std::sort(samples.begin(), samples.end());
+    const std::size_t count = samples.size();
+    result.min = samples.front();
+    result.median = count % 2 == 1 ? samples[count / 2] : (samples[count / 2 - 1] + samples[count / 2]) / 2.0;
+    // nearest rank
+    const std::size_t rank = static_cast<std::size_t>(std::ceil(0.99 * static_cast<double>(count)));
+    result.p99 = samples[std::max<std::size_t>(rank, 1) - 1];
+    result.mean = std::accumulate(samples.begin(), samples.end(), 0.0) / static_cast<double>(count);
+    return result;
+}
+
+bool BenchmarkResult::isCorrect() const
+{
+    if(error.empty() == false)
+    {
+        return false;
+    }
+    return expected.has_value() == false || *expected == answer;
+}
+
+BenchmarkResult benchmark(const Solver& solver, const BenchmarkOptions& options)
+{
+    BenchmarkResult result;
+    result.solver = &solver;
+    result.expected = solver.getExpectedAnswer();
+
+    const std::filesystem::path path = solver.getInputPath();
+    std::error_code error;
+    result.bytes = std::filesystem::file_size(path, error);
+    if(error)
+    {
+        result.error = "missing input " + path.string();
+        return result;
+    }
+
+    std::vector<double> totals;
+    std::vector<double> parses;
+    std::vector<double> solves;
+    const Clock::time_point begin = Clock::now();
+    const int runs = options.warmupIterations + std::max(options.iterations, 1);
+    for(int i = 0; i < runs; ++i)
+    {
+        const bool isWarmup = i < options.warmupIterations;
+        if(i > 0 && toSeconds(Clock::now() - begin) > options.maxSeconds)
+        {
+            if(isWarmup == false || totals.empty() == false)
+                break;
+            i = options.warmupIterations - 1;   // skip the remaining warmup, still measure once
+            continue;
+        }
+
+        ParseMark mark;
+        currentMark = &mark;
+        AllocationScope allocations;
+        const Clock::time_point start = Clock::now();
+        try
+        {
+            AOC_TRACE_SCOPE(solver.getName());
+            result.answer = solver.run(path);
+        }
+        catch(const std::exception& e)
+        {
+            result.error = e.what();
+        }
+        const Clock::time_point end = Clock::now();
+        currentMark = nullptr;
+        result.allocations = allocations.stop();
+        if(result.error.empty() == false)
+        {
+            return result;
+        }
+        if(isWarmup)
+        {
+            continue;
+        }
+
+        totals.push_back(toSeconds(end - start));
+        if(mark.isSet)
+        {
+            parses.push_back(toSeconds(mark.time - start));
+            solves.push_back(toSeconds(end - mark.time));
+            result.items = mark.items;
+        }
+    }
+
+    result.iterations = static_cast<int>(totals.size());
+    result.total = Statistics::compute(std::move(totals));
+    result.parse = Statistics::compute(std::move(parses));
+    result.solve = Statistics::compute(std::move(solves));
+    return result;
+}
+
+std::ostream& operator<<(std::ostream& stream, const BenchmarkResult& result)
+{
+    const Solver& solver = *result.solver;
+    stream << std::left << std::setw(28) << solver.getName() << std::right;
+    if(result.error.empty() == false)
+    {
+        return stream << "ERROR: " << result.error;
+    }
+
+    const auto flags = stream.flags();
+    stream << std::fixed << std::setprecision(3)
+        << (result.expected.has_value() == false ? "  ??  " : result.isCorrect() ? "  OK  " : "  FAIL")
+        << "  median " << std::setw(10) << result.total.median * 1000.0 << " ms"
+        << "  p99 " << std::setw(10) << result.total.p99 * 1000.0 << " ms";
+    if(result.hasParsePhase())
+    {
+        stream << "  parse " << std::setw(9) << result.parse.median * 1000.0 << " ms"
+            << "  solve " << std::setw(10) << result.solve.median * 1000.0 << " ms";
+    }
+    if(result.total.median > 0.0)
+    {
+        stream << "  " << std::setw(9) << static_cast<double>(result.bytes) / result.total.median / (1024.0 * 1024.0) << " MiB/s";
+        if(result.items > 0)
+        {
+            stream << "  " << std::setw(9) << static_cast<double>(result.items) / result.total.median / 1e6 << " M items/s";
+        }
+    }
+    stream << "  (" << result.iterations << "x)";
+    stream.flags(flags);
+    return stream;
+}
+
+void writeJson(std::ostream& stream, const std::vector<BenchmarkResult>& results)
+{
+    const auto flags = stream.flags();
+    const auto precision = stream.precision(9);
+    stream << "{\n  \"unit\": \"seconds\",\n  \"benchmarks\": [";
+    for(std::size_t i = 0; i < results.size(); ++i)
+    {
+        const BenchmarkResult& result = results[i];
+        const Solver& solver = *result.solver;
+        stream << (i == 0 ? "\n" : ",\n") << "    {\"name\": ";
+        writeJsonString(stream, solver.getName());
+        stream << ", \"day\": " << solver.day << ", \"part\": " << solver.part << ", \"input\": ";
+        writeJsonString(stream, solver.input);
+        if(result.error.empty() == false)
+        {
+            stream << ", \"error\": ";
+            writeJsonString(stream, result.error);
+            stream << "}";
+            continue;
+        }
+        stream << ", \"answer\": " << result.answer;
+        if(result.expected.has_value())
+        {
+            stream << ", \"expected\": " << *result.expected;
+        }
+        stream << ", \"correct\": " << (result.isCorrect() ? "true" : "false")
+            << ", \"iterations\": " << result.iterations
+            << ", \"bytes\": " << result.bytes << ", \"items\": " << result.items
+            << ",\n     \"total\": ";
+        writeJson(stream, result.total);
+        if(result.hasParsePhase())
+        {
+            stream << ",\n     \"parse\": ";
+            writeJson(stream, result.parse);
+            stream << ",\n     \"solve\": ";
+            writeJson(stream, result.solve);
+        }
+        const double median = result.total.median;
+        if(isTrackingAllocations())
+        {
+            stream << ",\n     \"allocations\": " << result.allocations.count << ", \"allocatedBytes\": " << result.allocations.bytes
+                << ", \"peakLiveBytes\": " << result.allocations.peakLiveBytes;
+        }
+        stream << ",\n     \"bytesPerSecond\": " << (median > 0.0 ? static_cast<double>(result.bytes) / median : 0.0)
+            << ", \"itemsPerSecond\": " << (median > 0.0 ? static_cast<double>(result.items) / median : 0.0) << "}";
+    }
+    stream << "\n  ]\n}\n";
+    stream.precision(precision);
+    stream.flags(flags);
+}
+
+void printMethodTime(std::ostream& stream, const char* method, double seconds, const std::vector<Rate>& rates)
+{
+    const auto flags = stream.flags();
+    const auto precision = stream.precision(1);
+    stream << std::fixed << "  " << std::left << std::setw(32) << method << std::right
+        << std::setw(10) << seconds * 1000.0 << " ms";
+    for(const Rate& rate : rates)
+    {
+        stream << std::setw(12) << rate.amount / seconds << " " << rate.unit;
+    }
+    stream << "\n";
+    stream.precision(precision);
+    stream.flags(flags);
+}
+
+}
@@ -0,0 +1,141 @@
+#pragma once
+
+#include "Allocations.hh"
+#include "Registry.hh"
+#include "Resources.hh"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+
+#include <optional>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Common
+{
+
+// Solvers call this once their input is parsed. Under a benchmark it splits the time of
+// the run into parse and solve, and records how many items (numbers, lines, records...)
+// were parsed for the items/s throughput (0 when there is no natural count). Outside a
+// benchmark it does nothing.
+void markParsed(std::size_t items);
+
+struct BenchmarkOptions
+{
+    int warmupIterations = 1;
+    int iterations = 10;
+    double maxSeconds = 10.0;   // per solver: stops repeating once exceeded, but always measures once
+};
+
+struct Statistics
+{
+    static Statistics compute(std::vector<double> samples);
+
+    double min = 0.0;
+    double median = 0.0;
+    double p99 = 0.0;
+    double mean = 0.0;
+};
+
+struct BenchmarkResult
+{
+    bool isCorrect() const;
+    bool hasParsePhase() const { return items > 0 || parse.median > 0.0; }
+
+    const Solver* solver = nullptr;
+    Answer answer = 0;
+    std::optional<Answer> expected;
+    int iterations = 0;
+    std::uint64_t bytes = 0;    // size of the input file
+    std::size_t items = 0;      // as reported by markParsed
+    Statistics total;           // seconds
+    Statistics parse;           // zero when the solver does not call markParsed
+    Statistics solve;
+    AllocationStats allocations;    // of the last run, zero unless built with AOC_TRACK_ALLOCATIONS
+    std::string error;          // set when the solver could not run
+};
+
+BenchmarkResult benchmark(const Solver& solver, const BenchmarkOptions& options = {});
+
+std::ostream& operator<<(std::ostream& stream, const BenchmarkResult& result);
+
+void writeJson(std::ostream& stream, const std::vector<BenchmarkResult>& results);
+
+// Throughput column of MethodComparison: amount / seconds followed by the unit, e.g.
+// {passports / 1e6, "M passports/s"}.
+struct Rate
+{
+    double amount;
+    const char* unit;
+};
+
+// One row of MethodComparison: the method, its time in ms and its rates.
+void printMethodTime(std::ostream& stream, const char* method, double seconds, const std::vector<Rate>& rates);
+
+// Times alternative implementations of one computation for the micro benchmarks in Bench/,
+// prints a row for each, and checks that each result equals the first one of the workload.
+// main returns getExitCode(), so a fast path that disagrees fails the run.
+template<typename Result>
+class MethodComparison
+{
+public:
+    explicit MethodComparison(std::ostream& stream) : stream(stream) {}
+
+    // Methods run from here on are only compared with each other, and their rates are per
+    // second of these amounts.
+    void startWorkload(std::vector<Rate> workloadRates)
+    {
+        rates = std::move(workloadRates);
+        reference.reset();
+    }
+
+    // Runs func once and checks its result. The result returned stays valid until the next run.
+    template<typename Func>
+    const Result& run(const char* method, Func func)
+    {
+        std::optional<Result>& result = reference.has_value() ? last : reference;
+        Stopwatch stopwatch;
+        result = func();
+        printMethodTime(stream, method, stopwatch.getSeconds(), rates);
+        if(&result == &last)
+        {
+            expect(*last == *reference, method);
+        }
+        return *result;
+    }
+
+    // Runs func once without checking its result, e.g. one of another type; expect() can
+    // compare it afterwards.
+    template<typename Func>
+    auto time(const char* method, Func func)
+    {
+        Stopwatch stopwatch;
+        auto result = func();
+        printMethodTime(stream, method, stopwatch.getSeconds(), rates);
+        return result;
+    }
+
+    void expect(bool isConsistent, const char* what)
+    {
+        if(isConsistent == false)
+        {
+            stream << "  INCONSISTENT RESULTS: " << what << "\n";
+            consistent = false;
+        }
+    }
+
+    bool isConsistent() const { return consistent; }
+    int getExitCode() const { return consistent ? EXIT_SUCCESS : EXIT_FAILURE; }
+
+private:
+    std::ostream& stream;
+    std::vector<Rate> rates;
+    std::optional<Result> reference;
+    std::optional<Result> last;
+    bool consistent = true;
+};
+
+}
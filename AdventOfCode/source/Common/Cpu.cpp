@@ -0,0 +1,72 @@
+#include "Cpu.hh"
+
+namespace Common
+{
+
+namespace
+{
+
+struct Features
+{
+    bool sse41 = false;
+    bool popcnt = false;
+    bool avx2 = false;
+};
+
+Features detectFeatures()
+{
+    Features features;
+#if defined(AOC_X86) && (defined(__GNUC__) || defined(__clang__))
+    __builtin_cpu_init();
+    features.sse41 = __builtin_cpu_supports("sse4.1");
+    features.popcnt = __builtin_cpu_supports("popcnt");
+    features.avx2 = __builtin_cpu_supports("avx2");
+#elif defined(AOC_X86) && defined(_MSC_VER)
+    int registers[4] = {};
+    __cpuid(registers, 0);
+    const int maxLeaf = registers[0];
+    if(maxLeaf < 1)
+        return features;
+
+    __cpuid(registers, 1);
+    const auto ecx = static_cast<unsigned>(registers[2]);
+    features.sse41 = (ecx >> 19) & 1;
+    features.popcnt = (ecx >> 23) & 1;
+
+    // AVX2 also needs the OS to save the YMM registers: OSXSAVE set and XCR0 holding
+    // both the SSE and the AVX state.
+    const bool osxsave = (ecx >> 27) & 1;
+    const bool avx = (ecx >> 28) & 1;
+    if(maxLeaf >= 7 && osxsave && avx && (_xgetbv(0) & 0x6) == 0x6)
+    {
+        __cpuidex(registers, 7, 0);
+        features.avx2 = (static_cast<unsigned>(registers[1]) >> 5) & 1;
+    }
+#endif
+    return features;
+}
+
+const Features& getFeatures()
+{
+    static const Features features = detectFeatures();
+    return features;
+}
+
+}
+
+bool hasSse41()
+{
+    return getFeatures().sse41;
+}
+
+bool hasPopcnt()
+{
+    return getFeatures().popcnt;
+}
+
+bool hasAvx2()
+{
+    return getFeatures().avx2;
+}
+
+}
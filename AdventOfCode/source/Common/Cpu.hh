@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define AOC_X86 1
+#include <immintrin.h>
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+// Marks a function that uses instructions beyond the baseline target, e.g.
+// AOC_TARGET("avx2"). Callers must check the matching hasX() first. MSVC emits any
+// intrinsic without it.
+#if defined(AOC_X86) && (defined(__GNUC__) || defined(__clang__))
+#define AOC_TARGET(features) __attribute__((target(features)))
+#else
+#define AOC_TARGET(features)
+#endif
+
+namespace Common
+{
+
+// Runtime CPU feature checks. They also make sure the OS saves the wide registers, and
+// they are always false off x86.
+bool hasSse41();
+bool hasPopcnt();
+bool hasAvx2();
+
+inline unsigned popcount(std::uint32_t value)
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+#ifdef __AVX__
+    return static_cast<unsigned>(__popcnt(value));
+#else
+    // __popcnt always emits POPCNT, which the baseline target does not guarantee.
+    value = value - ((value >> 1) & 0x55555555);
+    value = (value & 0x33333333) + ((value >> 2) & 0x33333333);
+    value = (value + (value >> 4)) & 0x0f0f0f0f;
+    return static_cast<unsigned>((value * 0x01010101) >> 24);
+#endif
+#else
+    return static_cast<unsigned>(__builtin_popcount(value));
+#endif
+}
+
+// Index of the lowest set bit; value must not be 0.
+inline unsigned countTrailingZeros(std::uint32_t value)
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    unsigned long index = 0;
+    _BitScanForward(&index, value);
+    return static_cast<unsigned>(index);
+#else
+    return static_cast<unsigned>(__builtin_ctz(value));
+#endif
+}
+
+inline unsigned countTrailingZeros(std::uint64_t value)
+{
+#if defined(_MSC_VER) && !defined(__clang__) && defined(_M_IX86)
+    const auto low = static_cast<std::uint32_t>(value);
+    return low != 0 ? countTrailingZeros(low) : 32 + countTrailingZeros(static_cast<std::uint32_t>(value >> 32));
+#elif defined(_MSC_VER) && !defined(__clang__)
+    unsigned long index = 0;
+    _BitScanForward64(&index, value);
+    return static_cast<unsigned>(index);
+#else
+    return static_cast<unsigned>(__builtin_ctzll(value));
+#endif
+}
+
+// Index of the highest set bit; value must not be 0.
+inline unsigned getHighestBit(std::uint64_t value)
+{
+#if defined(_MSC_VER) && !defined(__clang__) && defined(_M_IX86)
+    unsigned long index = 0;
+    const auto high = static_cast<std::uint32_t>(value >> 32);
+    if(high != 0)
+    {
+        _BitScanReverse(&index, high);
+        return 32 + static_cast<unsigned>(index);
+    }
+    _BitScanReverse(&index, static_cast<std::uint32_t>(value));
+    return static_cast<unsigned>(index);
+#elif defined(_MSC_VER) && !defined(__clang__)
+    unsigned long index = 0;
+    _BitScanReverse64(&index, value);
+    return static_cast<unsigned>(index);
+#else
+    return 63 - static_cast<unsigned>(__builtin_clzll(value));
+#endif
+}
+
+}
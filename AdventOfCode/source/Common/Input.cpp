@@ -0,0 +1,225 @@
+#include "Input.hh"
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <utility>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Common
+{
+
+MappedFile::MappedFile(const std::filesystem::path& path)
+{
+#ifndef _WIN32
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if(fd >= 0)
+    {
+        struct stat status{};
+        if(::fstat(fd, &status) == 0)
+        {
+            open = true;
+            size = static_cast<std::size_t>(status.st_size);
+            if(size > 0)
+            {
+                void* address = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE | MAP_POPULATE, fd, 0);
+                if(address != MAP_FAILED)
+                {
+                    ::madvise(address, size, MADV_SEQUENTIAL);
+                    data = static_cast<const char*>(address);
+                    mapped = true;
+                }
+            }
+        }
+        ::close(fd);
+        if(open && (mapped || size == 0))
+        {
+            return;
+        }
+    }
+#endif
+    // not mappable (or no mmap): fall back to one read into an owned buffer
+    std::ifstream file{path, std::ios::binary};
+    open = static_cast<bool>(file);
+    buffer.assign(std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{});
+    data = buffer.data();
+    size = buffer.size();
+}
+
+MappedFile::~MappedFile()
+{
+    release();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+{
+    *this = std::move(other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+    if(this != &other)
+    {
+        release();
+        open = std::exchange(other.open, false);
+        mapped = std::exchange(other.mapped, false);
+        size = std::exchange(other.size, 0);
+        buffer = std::move(other.buffer);
+        data = mapped ? std::exchange(other.data, nullptr) : buffer.data();
+        other.data = nullptr;
+    }
+    return *this;
+}
+
+void MappedFile::release()
+{
+#ifndef _WIN32
+    if(mapped)
+    {
+        ::munmap(const_cast<char*>(data), size);
+    }
+#endif
+    data = nullptr;
+    size = 0;
+    mapped = false;
+}
+
+bool nextLine(std::string_view& rest, std::string_view& line, char)
+{
+    if(rest.empty())
+    {
+        return false;
+    }
+    auto pos = rest.find('\n');
+    line = rest.substr(0, pos);
+    rest.remove_prefix(pos == std::string_view::npos ? rest.size() : pos + 1);
+    if(line.empty() == false && line.back() == '\r')
+    {
+        line.remove_suffix(1);
+    }
+    return true;
+}
+
+bool nextRecord(std::string_view& rest, std::string_view& record, char)
+{
+    // a record ends at an empty line; runs of empty lines do not produce empty records
+    std::string_view line;
+    while(rest.empty() == false && (rest.front() == '\n' || rest.front() == '\r'))
+    {
+        nextLine(rest, line, 0);
+    }
+    if(rest.empty())
+    {
+        return false;
+    }
+    const char* begin = rest.data();
+    const char* end = begin;
+    while(nextLine(rest, line, 0) && line.empty() == false)
+    {
+        end = line.data() + line.size();
+    }
+    record = std::string_view{begin, static_cast<std::size_t>(end - begin)};
+    return true;
+}
+
+bool nextToken(std::string_view& rest, std::string_view& token, char delimiter)
+{
+    auto isSeparator = [delimiter](char c)
+    {
+        return c == ' ' || c == '\n' || c == '\r' || c == '\t' || (delimiter != 0 && c == delimiter);
+    };
+    std::size_t begin = 0;
+    while(begin < rest.size() && isSeparator(rest[begin]))
+    {
+        ++begin;
+    }
+    if(begin == rest.size())
+    {
+        rest = {};
+        return false;
+    }
+    std::size_t end = begin;
+    while(end < rest.size() && isSeparator(rest[end]) == false)
+    {
+        ++end;
+    }
+    token = rest.substr(begin, end - begin);
+    rest.remove_prefix(end);
+    return true;
+}
+
+namespace
+{
+
+constexpr std::size_t MIN_CHUNK_SIZE = 64 * 1024;
+constexpr std::size_t CHUNKS_PER_THREAD = 4;
+
+// Position just after the line end at or after pos; an empty line too when atRecord.
+std::size_t findChunkEnd(std::string_view input, std::size_t pos, bool atRecord)
+{
+    for(;;)
+    {
+        pos = input.find('\n', pos);
+        if(pos == std::string_view::npos)
+        {
+            return input.size();
+        }
+        ++pos;
+        if(atRecord == false)
+        {
+            return pos;
+        }
+        std::size_t next = pos;
+        if(next < input.size() && input[next] == '\r')
+        {
+            ++next;
+        }
+        if(next < input.size() && input[next] == '\n')
+        {
+            return next + 1;
+        }
+    }
+}
+
+std::vector<std::string_view> splitChunks(std::string_view input, std::size_t numChunks, bool atRecords)
+{
+    numChunks = std::max<std::size_t>(numChunks, 1);
+    std::vector<std::string_view> chunks;
+    chunks.reserve(numChunks);
+    std::size_t begin = 0;
+    for(std::size_t i = 1; i < numChunks; ++i)
+    {
+        const std::size_t cut = std::max(begin, input.size() * i / numChunks);
+        const std::size_t end = cut == 0 ? 0 : findChunkEnd(input, cut - 1, atRecords);
+        chunks.push_back(input.substr(begin, end - begin));
+        begin = end;
+    }
+    chunks.push_back(input.substr(begin));
+    return chunks;
+}
+
+}
+
+std::vector<std::string_view> splitLineChunks(std::string_view input, std::size_t numChunks)
+{
+    return splitChunks(input, numChunks, false);
+}
+
+std::vector<std::string_view> splitRecordChunks(std::string_view input, std::size_t numChunks)
+{
+    return splitChunks(input, numChunks, true);
+}
+
+std::size_t getNumChunks(std::size_t inputSize, std::size_t numThreads)
+{
+    const std::size_t maxChunks = std::max<std::size_t>(numThreads, 1) * CHUNKS_PER_THREAD;
+    return std::clamp<std::size_t>(inputSize / MIN_CHUNK_SIZE, 1, maxChunks);
+}
+
+}
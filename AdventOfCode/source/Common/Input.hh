@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cstddef>
+
+#include <filesystem>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Common
+{
+
+// Read-only view of a whole puzzle input. The file is memory mapped where the platform
+// allows it, so the views handed out point straight into the page cache and stay valid
+// for the lifetime of the MappedFile.
+struct MappedFile
+{
+public:
+    explicit MappedFile(const std::filesystem::path& path);
+    ~MappedFile();
+
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool isOpen() const { return open; }
+    std::string_view getContent() const { return {data, size}; }
+
+private:
+    void release();
+
+    const char* data = nullptr;
+    std::size_t size = 0;
+    bool open = false;
+    bool mapped = false;
+    std::string buffer;     // holds the content when it could not be mapped
+};
+
+// Splitters: take the next item off the front of rest, return false once rest is exhausted.
+bool nextLine(std::string_view& rest, std::string_view& line, char);         // '\n' separated, "\r\n" tolerated
+bool nextRecord(std::string_view& rest, std::string_view& record, char);     // blank line separated, without the final newline
+bool nextToken(std::string_view& rest, std::string_view& token, char delimiter);   // separated by whitespace and delimiter, empties skipped
+
+template<bool (*Next)(std::string_view&, std::string_view&, char)>
+struct SplitRange
+{
+public:
+    struct iterator
+    {
+        using iterator_category = std::input_iterator_tag;
+        using value_type = std::string_view;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const std::string_view*;
+        using reference = const std::string_view&;
+
+        iterator() = default;
+        iterator(std::string_view rest, char delimiter) : rest{rest}, delimiter{delimiter} { ++*this; }
+
+        reference operator*() const { return current; }
+        pointer operator->() const { return &current; }
+        iterator& operator++()
+        {
+            atEnd = Next(rest, current, delimiter) == false;
+            return *this;
+        }
+        bool operator==(const iterator& other) const { return atEnd && other.atEnd; }
+        bool operator!=(const iterator& other) const { return !(*this == other); }
+
+    private:
+        std::string_view rest;
+        std::string_view current;
+        char delimiter = 0;
+        bool atEnd = true;
+    };
+
+    explicit SplitRange(std::string_view input, char delimiter = 0) : input{input}, delimiter{delimiter} {}
+
+    iterator begin() const { return {input, delimiter}; }
+    iterator end() const { return {}; }
+
+private:
+    std::string_view input;
+    char delimiter;
+};
+
+using Lines = SplitRange<nextLine>;
+using Records = SplitRange<nextRecord>;
+using Tokens = SplitRange<nextToken>;
+
+// Cuts input into numChunks pieces of about equal size for parallel parsing. Every cut is
+// moved forward to just after the next line end, or the next empty line for records, so no
+// line or record straddles two chunks; chunks may come out empty on short inputs.
+std::vector<std::string_view> splitLineChunks(std::string_view input, std::size_t numChunks);
+std::vector<std::string_view> splitRecordChunks(std::string_view input, std::size_t numChunks);
+
+// Enough chunks to balance numThreads, but none smaller than a few pages so small inputs
+// are not split at all.
+std::size_t getNumChunks(std::size_t inputSize, std::size_t numThreads);
+
+}
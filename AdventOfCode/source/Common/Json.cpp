@@ -0,0 +1,32 @@
+#include "Json.hh"
+
+namespace Common
+{
+
+void writeJsonString(std::ostream& stream, std::string_view text)
+{
+    constexpr char HEX_DIGITS[] = "0123456789abcdef";
+    stream << '"';
+    for(char c : text)
+    {
+        if(c == '"' || c == '\\')
+        {
+            stream << '\\' << c;
+        }
+        else if(c == '\n')
+        {
+            stream << "\\n";
+        }
+        else if(static_cast<unsigned char>(c) < 0x20)
+        {
+            stream << "\\u00" << HEX_DIGITS[(c >> 4) & 0xf] << HEX_DIGITS[c & 0xf];
+        }
+        else
+        {
+            stream << c;
+        }
+    }
+    stream << '"';
+}
+
+}
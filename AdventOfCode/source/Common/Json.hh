@@ -0,0 +1,12 @@
+#pragma once
+
+#include <ostream>
+#include <string_view>
+
+namespace Common
+{
+
+// Writes text as a quoted JSON string, escaping quotes, backslashes and control characters.
+void writeJsonString(std::ostream& stream, std::string_view text);
+
+}
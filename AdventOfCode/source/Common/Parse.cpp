@@ -0,0 +1,146 @@
+#include "Parse.hh"
+
+#include "Cpu.hh"
+
+#include <array>
+
+namespace Common
+{
+
+namespace
+{
+
+bool isDigit(char c)
+{
+    return static_cast<unsigned char>(c - '0') < 10;
+}
+
+const char* parseScalar(const char* it, const char* end, std::uint64_t*& out)
+{
+    while(it != end)
+    {
+        while(it != end && isDigit(*it) == false)
+            ++it;
+        if(it == end)
+            break;
+        std::uint64_t value = 0;
+        for(; it != end && isDigit(*it); ++it)
+            value = value * 10 + static_cast<std::uint64_t>(*it - '0');
+        *out++ = value;
+    }
+    return it;
+}
+
+#ifdef AOC_X86
+
+constexpr std::size_t LANES = 16;
+
+// ALIGN_RIGHT[n] moves the first n bytes of a vector to its last n bytes and zeroes the rest.
+constexpr std::array<std::array<std::int8_t, LANES>, LANES + 1> makeAlignRight()
+{
+    std::array<std::array<std::int8_t, LANES>, LANES + 1> result{};
+    for(std::size_t n = 0; n <= LANES; ++n)
+    {
+        for(std::size_t i = 0; i < LANES; ++i)
+        {
+            result[n][i] = i < LANES - n ? static_cast<std::int8_t>(-128) : static_cast<std::int8_t>(i - (LANES - n));
+        }
+    }
+    return result;
+}
+
+alignas(16) constexpr auto ALIGN_RIGHT = makeAlignRight();
+
+// Classifies 16 bytes at a time and converts every number that ends inside the window:
+// its digits are right-aligned with one shuffle and folded pairwise (x10, x100, x10000, x10^8).
+AOC_TARGET("sse4.1")
+const char* parseSse41(const char* it, const char* end, std::uint64_t*& out)
+{
+    const __m128i zero = _mm_set1_epi8('0');
+    const __m128i nine = _mm_set1_epi8(9);
+    const __m128i weights10 = _mm_set_epi8(1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10);
+    const __m128i weights100 = _mm_set_epi16(1, 100, 1, 100, 1, 100, 1, 100);
+    const __m128i weights10000 = _mm_set_epi16(1, 10000, 1, 10000, 1, 10000, 1, 10000);
+
+    while(end - it >= static_cast<std::ptrdiff_t>(LANES))
+    {
+        const __m128i digits = _mm_sub_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(it)), zero);
+        const __m128i digitLanes = _mm_cmpeq_epi8(_mm_min_epu8(digits, nine), digits);
+        const unsigned digitMask = static_cast<unsigned>(_mm_movemask_epi8(digitLanes));
+
+        unsigned position = 0;
+        for(;;)
+        {
+            const unsigned remaining = digitMask >> position;
+            if(remaining == 0)
+            {
+                position = LANES;
+                break;
+            }
+            const unsigned start = position + countTrailingZeros(remaining);
+            const unsigned length = countTrailingZeros(~(digitMask >> start));
+            if(start + length == LANES)
+            {
+                position = start;   // may continue past the window: reload starting at it
+                break;
+            }
+            // the table entries for "zero" have the high bit set, which survives adding the offset
+            const __m128i shuffle = _mm_add_epi8(
+                _mm_load_si128(reinterpret_cast<const __m128i*>(ALIGN_RIGHT[length].data())),
+                _mm_set1_epi8(static_cast<char>(start)));
+            const __m128i aligned = _mm_shuffle_epi8(digits, shuffle);
+            const __m128i pairs = _mm_maddubs_epi16(aligned, weights10);
+            const __m128i quads = _mm_madd_epi16(pairs, weights100);
+            const __m128i octs = _mm_madd_epi16(_mm_packus_epi32(quads, quads), weights10000);
+            const std::uint64_t high = static_cast<std::uint32_t>(_mm_cvtsi128_si32(octs));
+            const std::uint64_t low = static_cast<std::uint32_t>(_mm_extract_epi32(octs, 1));
+            *out++ = high * 100000000 + low;
+            position = start + length;
+        }
+
+        if(position == 0)
+        {
+            // 16+ digits do not fit one vector, these are rare enough to go one by one
+            std::uint64_t value = 0;
+            for(; it != end && isDigit(*it); ++it)
+                value = value * 10 + static_cast<std::uint64_t>(*it - '0');
+            *out++ = value;
+            continue;
+        }
+        it += position;
+    }
+    return it;
+}
+
+#endif
+
+}
+
+bool hasSimdNumberParser()
+{
+    return hasSse41();
+}
+
+std::size_t parseNumbersScalar(std::string_view input, std::uint64_t* out)
+{
+    std::uint64_t* begin = out;
+    parseScalar(input.data(), input.data() + input.size(), out);
+    return static_cast<std::size_t>(out - begin);
+}
+
+std::size_t parseNumbersSimd(std::string_view input, std::uint64_t* out)
+{
+    std::uint64_t* begin = out;
+    const char* it = input.data();
+    const char* end = it + input.size();
+#ifdef AOC_X86
+    if(hasSimdNumberParser())
+    {
+        it = parseSse41(it, end, out);
+    }
+#endif
+    parseScalar(it, end, out);
+    return static_cast<std::size_t>(out - begin);
+}
+
+}
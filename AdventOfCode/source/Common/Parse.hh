@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+#include <charconv>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace Common
+{
+
+// Parses the integer at the front of text (optional '+' or '-' for signed types) and
+// removes it from text. Returns false and leaves text untouched when there is none.
+template<typename T>
+bool parseNumber(std::string_view& text, T& value)
+{
+    static_assert(std::is_integral_v<T>);
+    const char* begin = text.data();
+    const char* end = begin + text.size();
+    if constexpr(std::is_signed_v<T>)
+    {
+        if(begin != end && *begin == '+')
+            ++begin;
+    }
+    auto [ptr, error] = std::from_chars(begin, end, value);
+    if(error != std::errc{})
+        return false;
+    text.remove_prefix(static_cast<std::size_t>(ptr - text.data()));
+    return true;
+}
+
+// Malformed input met by a loader. The runner reports it as the error of the solver.
+struct ParseError : std::runtime_error
+{
+    using std::runtime_error::runtime_error;
+};
+
+// The whole of text must be an integer that fits T, otherwise throws ParseError.
+template<typename T>
+T toNumber(std::string_view text)
+{
+    T value{};
+    std::string_view rest = text;
+    if(parseNumber(rest, value) == false || rest.empty() == false)
+    {
+        throw ParseError{"not a number: \"" + std::string{text} + "\""};
+    }
+    return value;
+}
+
+// Bulk parsers for runs of non-negative integers separated by any non-digit characters
+// (newlines, commas, spaces...). They write to out, which must have room for
+// getMaxNumberCount(input) values, and return the number of values written.
+constexpr std::size_t getMaxNumberCount(std::string_view input) { return input.size() / 2 + 1; }
+std::size_t parseNumbersScalar(std::string_view input, std::uint64_t* out);
+std::size_t parseNumbersSimd(std::string_view input, std::uint64_t* out);    // scalar when the CPU has no SSE4.1
+bool hasSimdNumberParser();
+
+inline std::size_t parseNumbers(std::string_view input, std::uint64_t* out)
+{
+    return parseNumbersSimd(input, out);
+}
+
+template<typename T = std::uint64_t>
+std::vector<T> parseNumbers(std::string_view input)
+{
+    std::vector<std::uint64_t> values(getMaxNumberCount(input));
+    values.resize(parseNumbers(input, values.data()));
+    if constexpr(std::is_same_v<T, std::uint64_t>)
+    {
+        return values;
+    }
+    else
+    {
+        return std::vector<T>(values.begin(), values.end());
+    }
+}
+
+}
@@ -0,0 +1,111 @@
+#include "Registry.hh"
+
+#include "Input.hh"
+#include "Parse.hh"
+
+#include <algorithm>
+#include <string_view>
+#include <tuple>
+
+namespace Common
+{
+
+namespace
+{
+
+std::filesystem::path getDefaultDataDirectory()
+{
+#ifdef AOC_DATA_DIR
+    return std::filesystem::path{AOC_DATA_DIR};
+#else
+    // the Visual Studio project runs from project/, next to data/
+    return std::filesystem::current_path().parent_path() / "data";
+#endif
+}
+
+std::filesystem::path& dataDirectory()
+{
+    static std::filesystem::path path{getDefaultDataDirectory()};
+    return path;
+}
+
+}
+
+std::filesystem::path Solver::getInputPath() const
+{
+    return Registry::getDataDirectory() / "PuzzleInput" / input;
+}
+
+std::string Solver::getName() const
+{
+    return "Day" + std::to_string(day) + " part" + std::to_string(part) + " [" + input + "]";
+}
+
+// answers.txt holds one "<input> <part> <answer>" per line, # starts a comment
+std::optional<Answer> Solver::getExpectedAnswer() const
+{
+    const std::filesystem::path inputPath = getInputPath();
+    MappedFile file{inputPath.parent_path() / "answers.txt"};
+    if(file.isOpen() == false)
+    {
+        return std::nullopt;
+    }
+    const std::string inputName = inputPath.filename().string();
+    for(std::string_view line : Lines{file.getContent()})
+    {
+        std::string_view fields[3];
+        std::size_t count = 0;
+        for(std::string_view token : Tokens{line})
+        {
+            if(count == 3 || token.front() == '#')
+                break;
+            fields[count++] = token;
+        }
+        int answerPart = 0;
+        Answer answer = 0;
+        if(count == 3 && fields[0] == inputName && parseNumber(fields[1], answerPart) && answerPart == part && parseNumber(fields[2], answer))
+        {
+            return answer;
+        }
+    }
+    return std::nullopt;
+}
+
+Registry& Registry::instance()
+{
+    static Registry registry;
+    return registry;
+}
+
+void Registry::add(Solver solver)
+{
+    auto key = [](const Solver& solver)
+    {
+        return std::tie(solver.day, solver.part, solver.input);
+    };
+    auto it = std::upper_bound(solvers.begin(), solvers.end(), solver, [key](const Solver& lhs, const Solver& rhs)
+    {
+        return key(lhs) < key(rhs);
+    });
+    solvers.insert(it, std::move(solver));
+}
+
+std::filesystem::path Registry::getDataDirectory()
+{
+    return dataDirectory();
+}
+
+void Registry::setDataDirectory(const std::filesystem::path& path)
+{
+    dataDirectory() = path;
+}
+
+Registration::Registration(std::initializer_list<Solver> solvers)
+{
+    for(const Solver& solver : solvers)
+    {
+        Registry::instance().add(solver);
+    }
+}
+
+}
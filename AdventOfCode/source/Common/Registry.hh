@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstdint>
+
+#include <filesystem>
+#include <functional>
+#include <initializer_list>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace Common
+{
+
+using Answer = std::uint64_t;
+using SolverFunc = std::function<Answer(const std::filesystem::path& path)>;
+
+struct Solver
+{
+    std::filesystem::path getInputPath() const;
+    std::string getName() const;
+    // From the answers.txt next to the input, so optimised builds verify their results without asserts.
+    std::optional<Answer> getExpectedAnswer() const;
+
+    int day = 0;
+    int part = 0;
+    std::string input;                  // relative to data/PuzzleInput, e.g. "Day12/test"
+    SolverFunc run;
+};
+
+struct Registry
+{
+public:
+    static Registry& instance();
+
+    void add(Solver solver);
+    const std::vector<Solver>& getSolvers() const { return solvers; }   // ordered by day, part, input
+
+    static std::filesystem::path getDataDirectory();
+    static void setDataDirectory(const std::filesystem::path& path);
+
+private:
+    std::vector<Solver> solvers;
+};
+
+// Each DayN.cpp holds a static Registration listing its solvers, so adding a day never touches main.cpp.
+struct Registration
+{
+    Registration(std::initializer_list<Solver> solvers);
+};
+
+}
@@ -0,0 +1,58 @@
+#include "Resources.hh"
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+#include <fstream>
+#include <string>
+
+namespace Common
+{
+
+bool resetPeakMemory()
+{
+#ifdef __linux__
+    // writing 5 to clear_refs resets VmHWM, see proc(5)
+    std::ofstream clearRefs{"/proc/self/clear_refs"};
+    clearRefs << "5";
+    clearRefs.flush();
+    return static_cast<bool>(clearRefs);
+#else
+    return false;
+#endif
+}
+
+std::uint64_t getPeakMemory()
+{
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS counters{};
+    GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters));
+    return counters.PeakWorkingSetSize;
+#else
+#ifdef __linux__
+    std::ifstream status{"/proc/self/status"};
+    static const std::string HWM_PREFIX = "VmHWM:";
+    for(std::string line; std::getline(status, line);)
+    {
+        if(line.compare(0, HWM_PREFIX.size(), HWM_PREFIX) == 0)
+        {
+            return std::stoull(line.substr(HWM_PREFIX.size())) * 1024;
+        }
+    }
+#endif
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+    return static_cast<std::uint64_t>(usage.ru_maxrss);
+#else
+    return static_cast<std::uint64_t>(usage.ru_maxrss) * 1024;
+#endif
+#endif
+}
+
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+namespace Common
+{
+
+struct Stopwatch
+{
+    using Clock = std::chrono::steady_clock;
+
+    double getSeconds() const { return std::chrono::duration<double>(Clock::now() - start).count(); }
+
+    Clock::time_point start = Clock::now();
+};
+
+// Resets the peak resident set size of the process to the current one, so the next
+// getPeakMemory() reports the peak of the code run in between. Returns false when the
+// platform cannot reset it, in which case the peak covers the whole process lifetime.
+bool resetPeakMemory();
+
+// Peak resident set size in bytes.
+std::uint64_t getPeakMemory();
+
+}
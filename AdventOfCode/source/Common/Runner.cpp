@@ -0,0 +1,99 @@
+#include "Runner.hh"
+
+#include "Resources.hh"
+#include "Trace.hh"
+
+#include <exception>
+#include <iomanip>
+#include <ostream>
+
+namespace Common
+{
+
+bool RunResult::isCorrect() const
+{
+    if(error.empty() == false)
+    {
+        return false;
+    }
+    return expected.has_value() == false || *expected == answer;
+}
+
+RunResult run(const Solver& solver, bool trackPeakMemory)
+{
+    RunResult result;
+    result.solver = &solver;
+    result.expected = solver.getExpectedAnswer();
+
+    const std::filesystem::path path = solver.getInputPath();
+    if(std::filesystem::exists(path) == false)
+    {
+        result.error = "missing input " + path.string();
+        return result;
+    }
+
+    if(trackPeakMemory)
+    {
+        resetPeakMemory();
+    }
+    AllocationScope allocations;
+    Stopwatch stopwatch;
+    try
+    {
+        AOC_TRACE_SCOPE(solver.getName());
+        result.answer = solver.run(path);
+    }
+    catch(const std::exception& e)
+    {
+        result.error = e.what();
+    }
+    result.seconds = stopwatch.getSeconds();
+    result.allocations = allocations.stop();
+    if(trackPeakMemory)
+    {
+        result.peakMemory = getPeakMemory();
+    }
+    return result;
+}
+
+std::ostream& operator<<(std::ostream& stream, const RunResult& result)
+{
+    const Solver& solver = *result.solver;
+    stream << std::left << std::setw(28) << solver.getName() << std::right;
+    if(result.error.empty() == false)
+    {
+        return stream << "ERROR: " << result.error;
+    }
+
+    stream << std::setw(16) << result.answer;
+    if(result.expected.has_value() == false)
+    {
+        stream << "  ??";
+    }
+    else if(result.isCorrect())
+    {
+        stream << "  OK";
+    }
+    else
+    {
+        stream << "  FAIL (expected " << *result.expected << ")";
+    }
+
+    const auto flags = stream.flags();
+    stream << std::fixed << std::setprecision(3)
+        << "  " << std::setw(10) << result.seconds * 1000.0 << " ms";
+    if(result.peakMemory > 0)
+    {
+        stream << "  " << std::setw(8) << static_cast<double>(result.peakMemory) / (1024.0 * 1024.0) << " MiB peak";
+    }
+    if(isTrackingAllocations())
+    {
+        stream << "  " << std::setw(10) << result.allocations.count << " allocs "
+            << std::setw(9) << static_cast<double>(result.allocations.bytes) / (1024.0 * 1024.0) << " MiB, peak live "
+            << std::setw(8) << static_cast<double>(result.allocations.peakLiveBytes) / (1024.0 * 1024.0) << " MiB";
+    }
+    stream.flags(flags);
+    return stream;
+}
+
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "Allocations.hh"
+#include "Registry.hh"
+
+#include <cstdint>
+
+#include <iosfwd>
+#include <optional>
+#include <string>
+
+namespace Common
+{
+
+struct RunResult
+{
+    bool isCorrect() const;
+
+    const Solver* solver = nullptr;
+    Answer answer = 0;
+    std::optional<Answer> expected;
+    double seconds = 0.0;
+    std::uint64_t peakMemory = 0;   // bytes, 0 when not tracked
+    AllocationStats allocations;    // zero unless built with AOC_TRACK_ALLOCATIONS
+    std::string error;              // set when the solver could not run
+};
+
+// Peak memory is process-wide, so it can only be attributed to a solver when nothing else runs concurrently.
+RunResult run(const Solver& solver, bool trackPeakMemory = true);
+
+std::ostream& operator<<(std::ostream& stream, const RunResult& result);
+
+}
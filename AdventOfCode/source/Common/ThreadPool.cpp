@@ -0,0 +1,130 @@
+#include "ThreadPool.hh"
+
+namespace Common
+{
+
+namespace
+{
+
+constexpr std::size_t NOT_A_WORKER = static_cast<std::size_t>(-1);
+thread_local const ThreadPool* currentPool = nullptr;
+thread_local std::size_t currentWorker = NOT_A_WORKER;
+
+}
+
+ThreadPool::ThreadPool(std::size_t numThreads)
+{
+    numThreads = std::max<std::size_t>(numThreads, 1);
+    for(std::size_t i = 0; i < numThreads; ++i)
+    {
+        queues.push_back(std::make_unique<Queue>());
+    }
+    for(std::size_t i = 0; i < numThreads; ++i)
+    {
+        threads.emplace_back([this, i]() { workerLoop(i); });
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard lock{mutex};
+        stopping = true;
+    }
+    condition.notify_all();
+    for(std::thread& thread : threads)
+    {
+        thread.join();
+    }
+}
+
+ThreadPool& ThreadPool::instance()
+{
+    static ThreadPool pool;
+    return pool;
+}
+
+std::size_t ThreadPool::getDefaultNumThreads()
+{
+    return std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+}
+
+void ThreadPool::push(Task task)
+{
+    std::size_t index = currentPool == this ? currentWorker : nextQueue++ % queues.size();
+    {
+        // counted before it is visible, so a worker can never take it and make the count underflow
+        std::lock_guard lock{mutex};
+        ++pendingCount;
+    }
+    {
+        Queue& queue = *queues[index];
+        std::lock_guard lock{queue.mutex};
+        queue.tasks.push_back(std::move(task));
+    }
+    condition.notify_one();
+}
+
+bool ThreadPool::tryPop(std::size_t index, Task& task)
+{
+    if(index != NOT_A_WORKER)
+    {
+        Queue& own = *queues[index];
+        std::lock_guard lock{own.mutex};
+        if(own.tasks.empty() == false)
+        {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            --pendingCount;
+            return true;
+        }
+    }
+    const std::size_t start = index == NOT_A_WORKER ? 0 : index + 1;
+    for(std::size_t i = 0; i < queues.size(); ++i)
+    {
+        Queue& victim = *queues[(start + i) % queues.size()];
+        std::lock_guard lock{victim.mutex};
+        if(victim.tasks.empty() == false)
+        {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            --pendingCount;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ThreadPool::tryRunPending()
+{
+    Task task;
+    if(tryPop(currentPool == this ? currentWorker : NOT_A_WORKER, task))
+    {
+        task();
+        return true;
+    }
+    return false;
+}
+
+void ThreadPool::workerLoop(std::size_t index)
+{
+    currentPool = this;
+    currentWorker = index;
+    for(;;)
+    {
+        Task task;
+        if(tryPop(index, task))
+        {
+            task();
+            continue;
+        }
+        std::unique_lock lock{mutex};
+        condition.wait(lock, [this]() { return stopping || pendingCount > 0; });
+        if(stopping && pendingCount == 0)
+        {
+            return;
+        }
+    }
+}
+
+}
@@ -0,0 +1,121 @@
+#pragma once
+
+#include "Allocations.hh"
+
+#include <cstddef>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace Common
+{
+
+// Work-stealing pool: every worker owns a deque, runs its own tasks newest first and
+// steals the oldest tasks of the other workers when it runs dry. Tasks submitted from
+// a worker go to its own deque, tasks from outside are distributed round-robin.
+struct ThreadPool
+{
+public:
+    explicit ThreadPool(std::size_t numThreads = getDefaultNumThreads());
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Pool shared by the solvers that parallelise internally.
+    static ThreadPool& instance();
+    static std::size_t getDefaultNumThreads();
+
+    std::size_t getNumThreads() const { return threads.size(); }
+
+    // The heap traffic of the task is charged to the submitting thread (see AllocationScope).
+    template<typename Func>
+    auto submit(Func func) -> std::future<std::invoke_result_t<Func>>;
+
+    // Waits for the future while running pending tasks, so tasks may wait on the
+    // tasks they submitted without starving the pool.
+    template<typename T>
+    T wait(std::future<T>& future);
+
+    // Calls func(begin, end) on consecutive subranges of [begin, end) of at most grainSize
+    // items in parallel and returns once all of them finished.
+    template<typename Func>
+    void parallelFor(std::size_t begin, std::size_t end, std::size_t grainSize, Func func);
+
+private:
+    using Task = std::function<void()>;
+
+    struct Queue
+    {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    void push(Task task);
+    bool tryPop(std::size_t index, Task& task);
+    bool tryRunPending();
+    void workerLoop(std::size_t index);
+
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::vector<std::thread> threads;
+
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::atomic<std::size_t> pendingCount{0};
+    std::atomic<std::size_t> nextQueue{0};
+    bool stopping = false;
+};
+
+template<typename Func>
+auto ThreadPool::submit(Func func) -> std::future<std::invoke_result_t<Func>>
+{
+    using Result = std::invoke_result_t<Func>;
+    auto task = std::make_shared<std::packaged_task<Result()>>([func = std::move(func), owner = getAllocationOwner()]() mutable -> Result
+    {
+        return runChargedTo(owner, func);
+    });
+    std::future<Result> future = task->get_future();
+    push([task]() { (*task)(); });
+    return future;
+}
+
+template<typename T>
+T ThreadPool::wait(std::future<T>& future)
+{
+    while(future.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+    {
+        if(tryRunPending() == false)
+        {
+            future.wait_for(std::chrono::microseconds(100));
+        }
+    }
+    return future.get();
+}
+
+template<typename Func>
+void ThreadPool::parallelFor(std::size_t begin, std::size_t end, std::size_t grainSize, Func func)
+{
+    grainSize = std::max<std::size_t>(grainSize, 1);
+    std::vector<std::future<void>> futures;
+    for(std::size_t chunkBegin = begin; chunkBegin < end; chunkBegin += grainSize)
+    {
+        std::size_t chunkEnd = std::min(end, chunkBegin + grainSize);
+        futures.push_back(submit([&func, chunkBegin, chunkEnd]() { func(chunkBegin, chunkEnd); }));
+    }
+    for(auto& future : futures)
+    {
+        wait(future);
+    }
+}
+
+}
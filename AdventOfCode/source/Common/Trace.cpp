@@ -0,0 +1,324 @@
+#include "Trace.hh"
+
+#include "Json.hh"
+
+#include <algorithm>
+#include <atomic>
+#include <iomanip>
+#include <mutex>
+#include <ostream>
+#include <tuple>
+#include <utility>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace Common
+{
+
+namespace
+{
+
+using Clock = std::chrono::steady_clock;
+constexpr std::size_t NUM_COUNTERS = static_cast<std::size_t>(Counter::NUM);
+
+std::mutex eventsMutex;
+std::atomic<std::uint64_t> nextThreadId{0};
+thread_local const std::uint64_t threadId = nextThreadId++;
+thread_local int depth = 0;
+
+// One perf event per counter for the calling thread, opened on first use.
+struct PerfEvents
+{
+    PerfEvents()
+    {
+#ifdef __linux__
+        static constexpr std::pair<std::uint32_t, std::uint64_t> EVENTS[NUM_COUNTERS] = {
+            {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+            {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+            {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+            {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+        };
+        for(std::size_t i = 0; i < NUM_COUNTERS; ++i)
+        {
+            perf_event_attr attr{};
+            attr.size = sizeof(attr);
+            attr.type = EVENTS[i].first;
+            attr.config = EVENTS[i].second;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            fds[i] = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+        }
+#endif
+    }
+
+    ~PerfEvents()
+    {
+#ifdef __linux__
+        for(int fd : fds)
+        {
+            if(fd >= 0)
+                close(fd);
+        }
+#endif
+    }
+
+    bool isOpen() const { return fds[0] >= 0; }
+
+    Counters read() const
+    {
+        Counters result{};
+#ifdef __linux__
+        for(std::size_t i = 0; i < NUM_COUNTERS; ++i)
+        {
+            std::uint64_t value = 0;
+            if(fds[i] >= 0 && ::read(fds[i], &value, sizeof(value)) == sizeof(value))
+                result[i] = value;
+        }
+#endif
+        return result;
+    }
+
+    int fds[NUM_COUNTERS] = {-1, -1, -1, -1};
+};
+
+PerfEvents& getPerfEvents()
+{
+    thread_local PerfEvents events;
+    return events;
+}
+
+}
+
+const char* getName(Counter counter)
+{
+    switch(counter)
+    {
+        case Counter::CYCLES:
+            return "cycles";
+        case Counter::INSTRUCTIONS:
+            return "instructions";
+        case Counter::CACHE_MISSES:
+            return "cache-misses";
+        case Counter::BRANCH_MISSES:
+            return "branch-misses";
+        default:
+            return "";
+    }
+}
+
+Counters readCounters()
+{
+    if(Tracer::instance().hasCounters() == false)
+    {
+        return {};
+    }
+    return getPerfEvents().read();
+}
+
+Tracer& Tracer::instance()
+{
+    static Tracer tracer;
+    return tracer;
+}
+
+bool Tracer::enable(bool withCounters)
+{
+    start = Clock::now();
+    this->withCounters = withCounters && getPerfEvents().isOpen();
+    enabled = true;
+    return this->withCounters == withCounters;
+}
+
+void Tracer::record(TraceEvent event)
+{
+    std::lock_guard lock{eventsMutex};
+    events.push_back(std::move(event));
+}
+
+std::vector<TraceEvent> Tracer::takeEvents()
+{
+    std::lock_guard lock{eventsMutex};
+    std::vector<TraceEvent> result = std::move(events);
+    events.clear();
+    // scopes are recorded when they end, inner before outer
+    std::sort(result.begin(), result.end(), [](const TraceEvent& lhs, const TraceEvent& rhs)
+    {
+        return std::tie(lhs.begin, lhs.depth) < std::tie(rhs.begin, rhs.depth);
+    });
+    return result;
+}
+
+void Tracer::writeChromeTrace(std::ostream& stream, const std::vector<TraceEvent>& events)
+{
+    const auto flags = stream.flags();
+    stream << std::fixed << std::setprecision(3) << "{\"traceEvents\": [";
+    for(std::size_t i = 0; i < events.size(); ++i)
+    {
+        const TraceEvent& event = events[i];
+        stream << (i == 0 ? "\n" : ",\n") << "  {\"name\": ";
+        writeJsonString(stream, event.name);
+        stream << ", \"ph\": \"X\", \"pid\": 1, \"tid\": " << event.thread
+            << ", \"ts\": " << event.begin * 1e6 << ", \"dur\": " << event.seconds * 1e6;
+        const bool hasCounters = event.counters != Counters{};
+        if(hasCounters || isTrackingAllocations())
+        {
+            stream << ", \"args\": {";
+            const char* separator = "";
+            for(std::size_t c = 0; c < NUM_COUNTERS && hasCounters; ++c, separator = ", ")
+            {
+                stream << separator << '"' << getName(static_cast<Counter>(c)) << "\": " << event.counters[c];
+            }
+            if(isTrackingAllocations())
+            {
+                stream << separator << "\"allocations\": " << event.allocations.count << ", \"allocatedBytes\": " << event.allocations.bytes
+                    << ", \"peakLiveBytes\": " << event.allocations.peakLiveBytes;
+            }
+            stream << "}";
+        }
+        stream << "}";
+    }
+    stream << "\n], \"displayTimeUnit\": \"ms\"}\n";
+    stream.flags(flags);
+}
+
+void Tracer::writeSummary(std::ostream& stream, const std::vector<TraceEvent>& events)
+{
+    struct Total
+    {
+        std::string path;
+        std::string name;
+        int depth = 0;
+        std::size_t count = 0;
+        double seconds = 0.0;
+        Counters counters{};
+        AllocationStats allocations;
+    };
+    struct Open
+    {
+        std::string path;
+        double end = 0.0;
+    };
+    std::vector<Total> totals;
+    std::vector<std::vector<Open>> openScopes;  // per thread, sorted events nest inside these
+    bool hasCounters = false;
+    for(const TraceEvent& event : events)
+    {
+        if(event.thread >= openScopes.size())
+        {
+            openScopes.resize(event.thread + 1);
+        }
+        std::vector<Open>& stack = openScopes[event.thread];
+        while(stack.empty() == false && (stack.size() > static_cast<std::size_t>(event.depth) || event.begin >= stack.back().end))
+        {
+            stack.pop_back();
+        }
+        std::string path = (stack.empty() ? std::string{} : stack.back().path + '/') + event.name;
+        stack.push_back({path, event.begin + event.seconds});
+
+        auto it = std::find_if(totals.begin(), totals.end(), [&path](const Total& total)
+        {
+            return total.path == path;
+        });
+        if(it == totals.end())
+        {
+            Total total;
+            total.path = std::move(path);
+            total.name = event.name;
+            total.depth = event.depth;
+            it = totals.insert(totals.end(), std::move(total));
+        }
+        ++it->count;
+        it->seconds += event.seconds;
+        it->allocations.count += event.allocations.count;
+        it->allocations.bytes += event.allocations.bytes;
+        it->allocations.peakLiveBytes = std::max(it->allocations.peakLiveBytes, event.allocations.peakLiveBytes);
+        for(std::size_t c = 0; c < NUM_COUNTERS; ++c)
+        {
+            it->counters[c] += event.counters[c];
+            hasCounters |= event.counters[c] > 0;
+        }
+    }
+
+    const auto flags = stream.flags();
+    stream << std::fixed << std::setprecision(3);
+    for(const Total& total : totals)
+    {
+        const std::string name = std::string(static_cast<std::size_t>(2 * total.depth), ' ') + total.name;
+        stream << "  " << std::left << std::setw(40) << name << std::right
+            << std::setw(8) << total.count << "x" << std::setw(12) << total.seconds * 1000.0 << " ms";
+        if(hasCounters)
+        {
+            for(std::size_t c = 0; c < NUM_COUNTERS; ++c)
+            {
+                stream << "  " << std::setw(14) << total.counters[c] << ' ' << getName(static_cast<Counter>(c));
+            }
+        }
+        if(isTrackingAllocations())
+        {
+            stream << "  " << std::setw(10) << total.allocations.count << " allocs"
+                << std::setw(10) << static_cast<double>(total.allocations.bytes) / (1024.0 * 1024.0) << " MiB"
+                << "  peak live " << std::setw(8) << static_cast<double>(total.allocations.peakLiveBytes) / (1024.0 * 1024.0) << " MiB";
+        }
+        stream << "\n";
+    }
+    stream.flags(flags);
+}
+
+TraceScope::TraceScope(const char* name) : staticName{name}
+{
+    begin();
+}
+
+TraceScope::TraceScope(std::string name) : name{std::move(name)}
+{
+    begin();
+}
+
+void TraceScope::begin()
+{
+    if(Tracer::instance().isEnabled() == false)
+    {
+        return;
+    }
+    active = true;
+    ++depth;
+    counters = readCounters();
+    if(isTrackingAllocations())
+    {
+        allocations.emplace();
+    }
+    start = Clock::now();
+}
+
+TraceScope::~TraceScope()
+{
+    if(active == false)
+    {
+        return;
+    }
+    const Clock::time_point end = Clock::now();
+    const Counters endCounters = readCounters();
+    const AllocationStats allocationStats = allocations ? allocations->stop() : AllocationStats{};
+    --depth;
+
+    Tracer& tracer = Tracer::instance();
+    TraceEvent event;
+    event.name = staticName != nullptr ? std::string{staticName} : std::move(name);
+    event.thread = threadId;
+    event.depth = depth;
+    event.begin = std::chrono::duration<double>(start - tracer.getStart()).count();
+    event.seconds = std::chrono::duration<double>(end - start).count();
+    for(std::size_t c = 0; c < NUM_COUNTERS; ++c)
+    {
+        event.counters[c] = endCounters[c] - counters[c];
+    }
+    event.allocations = allocationStats;
+    tracer.record(std::move(event));
+}
+
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+#include "Allocations.hh"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#include <array>
+#include <iosfwd>
+#include <optional>
+#include <string>
+#include <vector>
+
+// Scoped phase timers for looking inside a solver. AOC_TRACE_SCOPE("name") times the rest
+// of the enclosing block; scopes nest. They are compiled in only when AOC_TRACE is defined
+// to 1 (cmake -DAOC_TRACE=ON) and record only while tracing is enabled at runtime, so the
+// default build carries no cost at all.
+#if AOC_TRACE
+#define AOC_TRACE_CONCAT_IMPL(a, b) a##b
+#define AOC_TRACE_CONCAT(a, b) AOC_TRACE_CONCAT_IMPL(a, b)
+#define AOC_TRACE_SCOPE(name) const Common::TraceScope AOC_TRACE_CONCAT(traceScope, __LINE__){name}
+#else
+#define AOC_TRACE_SCOPE(name) static_cast<void>(0)
+#endif
+
+namespace Common
+{
+
+// Hardware counters read through perf_event_open for every scope, when available.
+enum class Counter
+{
+    CYCLES,
+    INSTRUCTIONS,
+    CACHE_MISSES,
+    BRANCH_MISSES,
+    NUM
+};
+using Counters = std::array<std::uint64_t, static_cast<std::size_t>(Counter::NUM)>;
+const char* getName(Counter counter);
+
+struct TraceEvent
+{
+    std::string name;
+    std::uint64_t thread = 0;   // small sequential id, not the OS thread id
+    int depth = 0;              // 0 for outermost scopes
+    double begin = 0.0;         // seconds since tracing was enabled
+    double seconds = 0.0;
+    Counters counters{};        // zero unless counters are enabled
+    AllocationStats allocations;    // zero unless built with AOC_TRACK_ALLOCATIONS
+};
+
+struct Tracer
+{
+public:
+    static Tracer& instance();
+
+    // Returns false when counters were requested but perf_event_open is not usable, e.g.
+    // because of /proc/sys/kernel/perf_event_paranoid; timings are still recorded.
+    bool enable(bool withCounters);
+    bool isEnabled() const { return enabled; }
+    bool hasCounters() const { return withCounters; }
+
+    void record(TraceEvent event);
+    std::vector<TraceEvent> takeEvents();
+
+    // Chrome trace event format, for chrome://tracing or https://ui.perfetto.dev
+    static void writeChromeTrace(std::ostream& stream, const std::vector<TraceEvent>& events);
+    // Time and counters summed per scope, keyed by the names of the enclosing scopes.
+    static void writeSummary(std::ostream& stream, const std::vector<TraceEvent>& events);
+
+    std::chrono::steady_clock::time_point getStart() const { return start; }
+
+private:
+    bool enabled = false;
+    bool withCounters = false;
+    std::chrono::steady_clock::time_point start;
+    std::vector<TraceEvent> events;
+};
+
+// Reads the counters of the calling thread; all zero when they are not enabled.
+Counters readCounters();
+
+struct TraceScope
+{
+public:
+    explicit TraceScope(const char* name);
+    explicit TraceScope(std::string name);
+    ~TraceScope();
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    void begin();
+
+    const char* staticName = nullptr;   // not copied unless tracing is enabled
+    std::string name;
+    bool active = false;
+    std::chrono::steady_clock::time_point start;
+    Counters counters{};
+    std::optional<AllocationScope> allocations;
+};
+
+}
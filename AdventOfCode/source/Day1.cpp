@@ -1,67 +1,77 @@
+#include "Common/Benchmark.hh"
+#include "Common/Input.hh"
+#include "Common/Parse.hh"
+#include "Common/Registry.hh"
+#include "Day1/KSum.hh"
+
 #include <cassert>
 
 #include <filesystem>
-#include <fstream>
 #include <iostream>
+#include <optional>
 #include <vector>
 
-std::vector<int> loadExpenseReport()
+namespace Day1
 {
-	std::filesystem::path path{ std::filesystem::current_path().parent_path() };
-	path += "/data/PuzzleInput/Day1/input.txt";
-	std::ifstream inputFile{ "../data/PuzzleInput/Day1/input.txt" };
 
-	int MAGIC = 2020;
+Values loadExpenseReport(const std::filesystem::path& path)
+{
+	Common::MappedFile inputFile{ path };
+	assert(inputFile.isOpen());
+	return Common::parseNumbers<Value>(inputFile.getContent());
+}
 
-	std::vector<int> numbers;
-	while (inputFile)
+// Product of the k entries that sum to target, 0 when there are none.
+std::uint64_t getAnswer(const std::filesystem::path& path, Value target, std::size_t k)
+{
+	const Values numbers{ loadExpenseReport(path) };
+	Common::markParsed(numbers.size());
+	const std::optional<Values> entries{ findSum(numbers, target, k) };
+	if (!entries)
 	{
-		int temp = 0;
-		inputFile >> temp;
-		if (inputFile)
-			numbers.push_back(temp);
+		return 0;
 	}
-	return numbers;
+	Value product = 1;
+	for (Value entry : *entries)
+	{
+		product *= entry;
+	}
+	return static_cast<std::uint64_t>(product);
+}
+
+std::uint64_t getAnswerPart1(const std::filesystem::path& path)
+{
+	return getAnswer(path, 2020, 2);
+}
+
+std::uint64_t getAnswerPart2(const std::filesystem::path& path)
+{
+	return getAnswer(path, 2020, 3);
 }
 
 void part1()
 {
-	const std::vector<int> numbers{ loadExpenseReport() };
-	int MAGIC = 2020;
-	int result = 0;
-	for (std::size_t i = 0; i < numbers.size(); ++i)
-	{
-		for (std::size_t j = i; j < numbers.size(); ++j)
-		{
-			if (numbers[i] + numbers[j] == MAGIC)
-			{
-				assert(result == 0);
-				result = numbers[i] * numbers[j];
-			}
-		}
-	}
+	std::filesystem::path path{ std::filesystem::current_path().parent_path() };
+	path += "/data/PuzzleInput/Day1/input.txt";
+	auto result = getAnswerPart1(path);
 	std::cout << "part1 result: " << result << "\n"; // 326211
 	assert(result == 326211);
 }
 
 void part2()
 {
-	const std::vector<int> numbers{ loadExpenseReport() };
-	int MAGIC = 2020;
-	int result = 0;
-	for (std::size_t i = 0; i < numbers.size(); ++i)
-	{
-		for (std::size_t j = i; j < numbers.size(); ++j)
-		{
-			for (std::size_t k = j; k < numbers.size(); ++k)
-			{
-				if (numbers[i] + numbers[j] + numbers[k] == MAGIC)
-				{
-					assert(result == 0);
-					result = numbers[i] * numbers[j] * numbers[k];
-				}
-			}
-		}
-	}
+	std::filesystem::path path{ std::filesystem::current_path().parent_path() };
+	path += "/data/PuzzleInput/Day1/input.txt";
+	auto result = getAnswerPart2(path);
 	std::cout << "part2 result: " << result << "\n"; // 131347190
-}
\ No newline at end of file
+}
+
+static const Common::Registration registration{
+	{ 1, 1, "Day1/input.txt", getAnswerPart1 },
+	{ 1, 1, "Day1/test", getAnswerPart1 },
+	{ 1, 1, "Day1/test2", getAnswerPart1 },
+	{ 1, 2, "Day1/input.txt", getAnswerPart2 },
+	{ 1, 2, "Day1/test", getAnswerPart2 },
+};
+
+}
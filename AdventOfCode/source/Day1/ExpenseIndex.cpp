@@ -0,0 +1,95 @@
+#include "ExpenseIndex.hh"
+
+#include "Common/ThreadPool.hh"
+
+#include <algorithm>
+
+namespace Day1
+{
+
+namespace
+{
+
+// Targets per task; a pair query is O(n) on its own, so keep the tasks coarse enough.
+constexpr std::size_t GRAIN_SIZE = 64;
+
+}
+
+ExpenseIndex::ExpenseIndex(Values numbers) : sorted{std::move(numbers)}
+{
+    std::sort(sorted.begin(), sorted.end());
+    if(sorted.empty())
+    {
+        return;
+    }
+    min = sorted.front();
+    max = sorted.back();
+    const std::uint64_t range = static_cast<std::uint64_t>(max - min) + 1;
+    if(isDenseRange(range, sorted.size()))
+    {
+        presence.resize((range + 63) / 64);
+        for(Value value : sorted)
+        {
+            const std::uint64_t bit = static_cast<std::uint64_t>(value - min);
+            presence[bit / 64] |= std::uint64_t{1} << (bit % 64);
+        }
+    }
+}
+
+bool ExpenseIndex::contains(Value value) const
+{
+    if(value < min || value > max)
+    {
+        return false;
+    }
+    if(presence.empty())
+    {
+        return std::binary_search(sorted.begin(), sorted.end(), value);
+    }
+    const std::uint64_t bit = static_cast<std::uint64_t>(value - min);
+    return (presence[bit / 64] >> (bit % 64)) & 1;
+}
+
+std::optional<Values> ExpenseIndex::findPair(Value target) const
+{
+    // the smaller entry of a pair is at most half the target
+    for(std::size_t i = 0; i < sorted.size() && 2 * sorted[i] <= target; ++i)
+    {
+        const Value value = sorted[i];
+        const Value complement = target - value;
+        if(complement == value ? i + 1 < sorted.size() && sorted[i + 1] == value : contains(complement))
+        {
+            return Values{value, complement};
+        }
+    }
+    return std::nullopt;
+}
+
+std::optional<Values> ExpenseIndex::find(Value target, std::size_t k) const
+{
+    if(k == 2)
+    {
+        return findPair(target);
+    }
+    return findSumSorted(sorted, target, k);
+}
+
+std::vector<std::optional<Values>> ExpenseIndex::findAll(const Values& targets, std::size_t k, Common::ThreadPool& pool) const
+{
+    std::vector<std::optional<Values>> results(targets.size());
+    pool.parallelFor(0, targets.size(), GRAIN_SIZE, [&](std::size_t begin, std::size_t end)
+    {
+        for(std::size_t i = begin; i < end; ++i)
+        {
+            results[i] = find(targets[i], k);
+        }
+    });
+    return results;
+}
+
+std::vector<std::optional<Values>> ExpenseIndex::findAll(const Values& targets, std::size_t k) const
+{
+    return findAll(targets, k, Common::ThreadPool::instance());
+}
+
+}
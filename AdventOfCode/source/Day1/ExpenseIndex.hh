@@ -0,0 +1,45 @@
+#pragma once
+
+#include "KSum.hh"
+
+#include <cstddef>
+#include <cstdint>
+
+#include <optional>
+#include <vector>
+
+namespace Common
+{
+struct ThreadPool;
+}
+
+namespace Day1
+{
+
+// An expense report prepared once for many target sums: the entries sorted, plus a bitmap
+// of the values present when the value range is dense enough for one.
+struct ExpenseIndex
+{
+public:
+    explicit ExpenseIndex(Values numbers);
+
+    // As findSum, without the per-query preparation.
+    std::optional<Values> find(Value target, std::size_t k) const;
+
+    // Answers every target of the batch, spread over the pool.
+    std::vector<std::optional<Values>> findAll(const Values& targets, std::size_t k, Common::ThreadPool& pool) const;
+    std::vector<std::optional<Values>> findAll(const Values& targets, std::size_t k) const;  // on the shared pool
+
+    std::size_t size() const { return sorted.size(); }
+
+private:
+    bool contains(Value value) const;
+    std::optional<Values> findPair(Value target) const;
+
+    Values sorted;
+    Value min = 0;
+    Value max = 0;
+    std::vector<std::uint64_t> presence;    // bit value - min, empty when too sparse
+};
+
+}
@@ -0,0 +1,234 @@
+#include "KSum.hh"
+
+#include <algorithm>
+#include <cassert>
+#include <iterator>
+
+namespace Day1
+{
+
+namespace
+{
+
+std::optional<Values> findPairWithBitmap(const Values& numbers, Value min, Value max, Value target)
+{
+    const std::uint64_t range = static_cast<std::uint64_t>(max - min) + 1;
+    std::vector<std::uint64_t> seen((range + 63) / 64);
+    for(Value value : numbers)
+    {
+        const Value complement = target - value;
+        if(complement >= min && complement <= max)
+        {
+            const std::uint64_t bit = static_cast<std::uint64_t>(complement - min);
+            if((seen[bit / 64] >> (bit % 64)) & 1)
+            {
+                return Values{std::min(value, complement), std::max(value, complement)};
+            }
+        }
+        const std::uint64_t bit = static_cast<std::uint64_t>(value - min);
+        seen[bit / 64] |= std::uint64_t{1} << (bit % 64);
+    }
+    return std::nullopt;
+}
+
+std::optional<Values> findPairWithHashSet(const Values& numbers, Value target)
+{
+    HashSet seen{numbers.size()};
+    for(Value value : numbers)
+    {
+        const Value complement = target - value;
+        if(seen.contains(complement))
+        {
+            return Values{std::min(value, complement), std::max(value, complement)};
+        }
+        seen.insert(value);
+    }
+    return std::nullopt;
+}
+
+std::optional<Values> findPair(const Values& numbers, Value target)
+{
+    if(numbers.size() < 2)
+    {
+        return std::nullopt;
+    }
+    const auto [minIt, maxIt] = std::minmax_element(numbers.begin(), numbers.end());
+    const std::uint64_t range = static_cast<std::uint64_t>(*maxIt - *minIt) + 1;
+    if(isDenseRange(range, numbers.size()))
+    {
+        return findPairWithBitmap(numbers, *minIt, *maxIt, target);
+    }
+    return findPairWithHashSet(numbers, target);
+}
+
+// Two entries of sorted[begin, end) summing to target.
+bool sweep(const Values& sorted, std::size_t begin, std::size_t end, Value target, Values& result)
+{
+    if(end - begin < 2)
+    {
+        return false;
+    }
+    // nothing above target - smallest can be part of a pair
+    std::size_t high = static_cast<std::size_t>(std::upper_bound(sorted.begin() + begin + 1, sorted.begin() + end, target - sorted[begin]) - sorted.begin());
+    if(high == begin + 1)
+    {
+        return false;
+    }
+    std::size_t low = begin;
+    --high;
+    while(low < high)
+    {
+        const Value sum = sorted[low] + sorted[high];
+        if(sum == target)
+        {
+            result.push_back(sorted[low]);
+            result.push_back(sorted[high]);
+            return true;
+        }
+        if(sum < target)
+            ++low;
+        else
+            --high;
+    }
+    return false;
+}
+
+// k entries of sorted[begin, end) summing to target, appended to result in ascending order.
+bool findSorted(const Values& sorted, std::size_t begin, Value target, std::size_t k, Values& result)
+{
+    const std::size_t end = sorted.size();
+    if(k == 2)
+    {
+        return sweep(sorted, begin, end, target, result);
+    }
+    for(std::size_t i = begin; i + k <= end; ++i)
+    {
+        if(i > begin && sorted[i] == sorted[i - 1])
+        {
+            continue;   // the same value was already tried with a superset of the remaining entries
+        }
+        Value smallest = 0;
+        Value largest = 0;
+        for(std::size_t j = 0; j < k; ++j)
+        {
+            smallest += sorted[i + j];
+            largest += j == 0 ? sorted[i] : sorted[end - j];
+        }
+        if(smallest > target)
+        {
+            break;      // every later choice is larger still
+        }
+        if(largest < target)
+        {
+            continue;
+        }
+        result.push_back(sorted[i]);
+        if(findSorted(sorted, i + 1, target - sorted[i], k - 1, result))
+        {
+            return true;
+        }
+        result.pop_back();
+    }
+    return false;
+}
+
+}
+
+bool isDenseRange(std::uint64_t range, std::size_t count)
+{
+    // bits per entry above which the bitmap stops paying off against the hash set
+    constexpr std::uint64_t MAX_BITS_PER_ENTRY = 64;
+    constexpr std::uint64_t MIN_BITMAP_BITS = 1 << 16;
+    return range != 0 && range <= std::max<std::uint64_t>(MIN_BITMAP_BITS, count * MAX_BITS_PER_ENTRY);
+}
+
+HashSet::HashSet(std::size_t expectedSize)
+{
+    unsigned bits = 4;
+    while((std::size_t{1} << bits) < expectedSize * 2)
+    {
+        ++bits;
+    }
+    slots.assign(std::size_t{1} << bits, EMPTY);
+    mask = slots.size() - 1;
+    shift = 64 - bits;
+}
+
+std::size_t HashSet::getSlot(Value value) const
+{
+    // Fibonacci hashing, the high bits are the well mixed ones
+    return static_cast<std::size_t>((static_cast<std::uint64_t>(value) * 0x9E3779B97F4A7C15ull) >> shift);
+}
+
+bool HashSet::contains(Value value) const
+{
+    if(value == EMPTY)
+    {
+        return containsEmpty;
+    }
+    for(std::size_t slot = getSlot(value);; slot = (slot + 1) & mask)
+    {
+        if(slots[slot] == value)
+            return true;
+        if(slots[slot] == EMPTY)
+            return false;
+    }
+}
+
+void HashSet::insert(Value value)
+{
+    if(value == EMPTY)
+    {
+        containsEmpty = true;
+        return;
+    }
+    std::size_t slot = getSlot(value);
+    for(; slots[slot] != EMPTY; slot = (slot + 1) & mask)
+    {
+        if(slots[slot] == value)
+            return;
+    }
+    slots[slot] = value;
+}
+
+std::optional<Values> findSumSorted(const Values& sorted, Value target, std::size_t k)
+{
+    assert(std::is_sorted(sorted.begin(), sorted.end()));
+    if(k == 0 || k > sorted.size())
+    {
+        return std::nullopt;
+    }
+    if(k == 1)
+    {
+        return std::binary_search(sorted.begin(), sorted.end(), target) ? std::optional<Values>{Values{target}} : std::nullopt;
+    }
+    Values result;
+    result.reserve(k);
+    if(findSorted(sorted, 0, target, k, result))
+    {
+        return result;
+    }
+    return std::nullopt;
+}
+
+std::optional<Values> findSum(const Values& numbers, Value target, std::size_t k)
+{
+    if(k == 2)
+    {
+        return findPair(numbers, target);
+    }
+    if(k == 0 || k > numbers.size())
+    {
+        return std::nullopt;
+    }
+    // an entry above target minus k - 1 times the smallest one can never take part, and
+    // dropping those first often leaves little to sort
+    const Value min = *std::min_element(numbers.begin(), numbers.end());
+    const Value bound = target - static_cast<Value>(k - 1) * min;
+    Values sorted;
+    std::copy_if(numbers.begin(), numbers.end(), std::back_inserter(sorted), [bound](Value value) { return value <= bound; });
+    std::sort(sorted.begin(), sorted.end());
+    return findSumSorted(sorted, target, k);
+}
+
+}
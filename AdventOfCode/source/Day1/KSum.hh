@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <optional>
+#include <vector>
+
+namespace Day1
+{
+
+using Value = std::int64_t;
+using Values = std::vector<Value>;
+
+// Finds k entries at distinct positions of numbers that add up to target and returns their
+// values in ascending order, or nothing when there are none. A value can be used as often
+// as it occurs.
+//  k == 2: one pass with a bitmap over the value range when that is dense enough, an open
+//          addressing hash set otherwise; O(n).
+//  k >= 3: sorts the entries that can take part at all and fixes the smallest k - 2 around
+//          a two-pointer sweep, skipping whatever the sorted order proves cannot reach the
+//          target; O(n^(k-1)) at worst.
+std::optional<Values> findSum(const Values& numbers, Value target, std::size_t k);
+
+// Whether a bitmap over a value range beats hashing count entries.
+bool isDenseRange(std::uint64_t range, std::size_t count);
+
+// Same as findSum, for numbers that are already sorted ascending.
+std::optional<Values> findSumSorted(const Values& sorted, Value target, std::size_t k);
+
+// Set of values with linear probing, for the pair search over sparse value ranges.
+struct HashSet
+{
+public:
+    explicit HashSet(std::size_t expectedSize);
+
+    bool contains(Value value) const;
+    void insert(Value value);
+
+private:
+    std::size_t getSlot(Value value) const;
+
+    static constexpr Value EMPTY = INT64_MIN;   // stored separately when it is a real value
+    std::vector<Value> slots;
+    std::size_t mask = 0;
+    unsigned shift = 0;
+    bool containsEmpty = false;
+};
+
+}
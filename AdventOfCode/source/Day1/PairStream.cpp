@@ -0,0 +1,68 @@
+#include "PairStream.hh"
+
+#include <cassert>
+
+#include <algorithm>
+
+namespace Day1
+{
+
+PairDetector::PairDetector(Value target)
+    : target{target}
+    , seen(target >= 0 ? static_cast<std::size_t>(target) / 64 + 1 : 0)
+{
+}
+
+std::optional<Values> PairDetector::add(Value value)
+{
+    assert(value >= 0);
+    if(value > target)
+    {
+        return std::nullopt;
+    }
+    const Value complement = target - value;
+    const auto complementBit = static_cast<std::size_t>(complement);
+    if((seen[complementBit / 64] >> (complementBit % 64)) & 1)
+    {
+        return Values{std::min(value, complement), std::max(value, complement)};
+    }
+    const auto bit = static_cast<std::size_t>(value);
+    seen[bit / 64] |= std::uint64_t{1} << (bit % 64);
+    return std::nullopt;
+}
+
+std::optional<Values> PairStream::add(Value value)
+{
+    ++numEntries;
+    return detector.add(value);
+}
+
+std::optional<Values> PairStream::feed(std::string_view chunk)
+{
+    for(char c : chunk)
+    {
+        if(c >= '0' && c <= '9')
+        {
+            current = current * 10 + (c - '0');
+            inNumber = true;
+        }
+        else if(inNumber)
+        {
+            inNumber = false;
+            const Value value = current;
+            current = 0;
+            if(auto pair = add(value))
+            {
+                return pair;
+            }
+        }
+    }
+    return std::nullopt;
+}
+
+std::optional<Values> PairStream::finish()
+{
+    return feed("\n");
+}
+
+}
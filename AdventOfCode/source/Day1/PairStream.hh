@@ -0,0 +1,50 @@
+#pragma once
+
+#include "KSum.hh"
+
+#include <cstdint>
+
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace Day1
+{
+
+// Reports the first pair of entries summing to target the moment its second entry is fed.
+// Entries are non-negative like the expense reports, so only values up to target can take
+// part: memory stays at one bit per value in [0, target] however many entries pass.
+struct PairDetector
+{
+public:
+    explicit PairDetector(Value target);
+
+    std::optional<Values> add(Value value);
+
+private:
+    Value target;
+    std::vector<std::uint64_t> seen;
+};
+
+// Feeds a PairDetector from text arriving in arbitrary chunks, e.g. a pipe; a number split
+// across two chunks is carried over.
+struct PairStream
+{
+public:
+    explicit PairStream(Value target) : detector{target} {}
+
+    std::optional<Values> feed(std::string_view chunk);
+    std::optional<Values> finish();     // at the end of the input, for a last number without a newline
+
+    std::uint64_t getNumEntries() const { return numEntries; }
+
+private:
+    std::optional<Values> add(Value value);
+
+    PairDetector detector;
+    std::uint64_t numEntries = 0;
+    Value current = 0;
+    bool inNumber = false;
+};
+
+}
@@ -0,0 +1,66 @@
+#include "Common/Resources.hh"
+#include "Day1/PairStream.hh"
+
+#include <cstdlib>
+
+#include <iostream>
+#include <string>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+// Reads an expense report from stdin as it arrives and prints the first pair summing to the
+// target as soon as it is complete, e.g. aoc_generate 1 100000000 | aoc_day1_stream
+
+namespace
+{
+
+long readChunk(char* buffer, unsigned size)
+{
+#ifdef _WIN32
+    return _read(0, buffer, size);
+#else
+    // returns whatever a pipe has, where std::istream::read would wait to fill the buffer
+    return static_cast<long>(read(STDIN_FILENO, buffer, size));
+#endif
+}
+
+}
+
+int main(int argc, char* argv[])
+{
+    const Day1::Value target = argc > 1 ? std::atoll(argv[1]) : 2020;
+    if(target < 0)
+    {
+        std::cerr << "usage: aoc_day1_stream [<target>] < report\n";
+        return EXIT_FAILURE;
+    }
+
+    Common::Stopwatch stopwatch;
+    Day1::PairStream stream{target};
+    std::optional<Day1::Values> pair;
+    static char buffer[1 << 16];
+    std::uint64_t bytes = 0;
+    for(long size = 0; !pair && (size = readChunk(buffer, sizeof(buffer))) > 0;)
+    {
+        bytes += static_cast<std::uint64_t>(size);
+        pair = stream.feed({buffer, static_cast<std::size_t>(size)});
+    }
+    if(!pair)
+    {
+        pair = stream.finish();
+    }
+
+    if(!pair)
+    {
+        std::cout << "no pair sums to " << target << " in " << stream.getNumEntries() << " entries\n";
+        return EXIT_FAILURE;
+    }
+    std::cout << (*pair)[0] << " + " << (*pair)[1] << " = " << target << ", product " << (*pair)[0] * (*pair)[1]
+        << ", found at entry " << stream.getNumEntries() << " after " << bytes << " bytes in "
+        << stopwatch.getSeconds() * 1000.0 << " ms\n";
+    return EXIT_SUCCESS;
+}
@@ -1,3 +1,8 @@
+#include "Common/Benchmark.hh"
+#include "Common/Input.hh"
+#include "Common/Parse.hh"
+#include "Common/Registry.hh"
+
 #include <cassert>
 
 #include <algorithm>
@@ -9,6 +14,7 @@
 #include <numeric>
 #include <set>
 #include <string>
+#include <string_view>
 #include <sstream>
 #include <vector>
 
@@ -18,29 +24,18 @@ namespace Day10
 using i64 = std::int64_t;
 using u64 = std::uint64_t;
 
-std::set<u64> loadAdapters(std::istream& stream)
+std::set<u64> loadAdapters(std::string_view input)
 {
-	std::set<u64> result;
-	for (;;)
-	{
-		u64 temp = 0;
-		stream >> temp;
-		if (stream)
-			result.insert(temp);
-		else
-			break;
-	}
-	return result;
+	std::vector<u64> numbers = Common::parseNumbers<u64>(input);
+	return std::set<u64>(numbers.begin(), numbers.end());
 }
 
-void part1()
+u64 getAnswerPart1(const std::filesystem::path& path)
 {
-	std::filesystem::path path{std::filesystem::current_path().parent_path()};
-	path += "/data/PuzzleInput/Day10/input.txt";
-	//path += "/data/PuzzleInput/Day10/test";
-	std::ifstream file{path};
-	assert(file);
-	std::set<u64> adapters = loadAdapters(file);
+	Common::MappedFile file{path};
+	assert(file.isOpen());
+	std::set<u64> adapters = loadAdapters(file.getContent());
+	Common::markParsed(adapters.size());
 	std::map<u64, u64> diff;
 
 	u64 prev = 0;
@@ -50,7 +45,15 @@ void part1()
 		prev = jolt;
 	}
 	++diff[3];
-    auto part1 = diff[1] * diff[3]; // 2100
+	return diff[1] * diff[3];
+}
+
+void part1()
+{
+	std::filesystem::path path{std::filesystem::current_path().parent_path()};
+	path += "/data/PuzzleInput/Day10/input.txt";
+	//path += "/data/PuzzleInput/Day10/test";
+    auto part1 = getAnswerPart1(path); // 2100
 	int debug = 123;
 }
 
@@ -100,15 +103,12 @@ u64 getNumberofPaths(const std::set<Node>& graph)
 	return sum;
 }
 
-void part2()
+u64 getAnswerPart2(const std::filesystem::path& path)
 {
-	std::filesystem::path path{std::filesystem::current_path().parent_path()};
-	path += "/data/PuzzleInput/Day10/input.txt";
-	//path += "/data/PuzzleInput/Day10/test";
-	//path += "/data/PuzzleInput/Day10/test2";
-	std::ifstream file{path};
-	assert(file);
-	std::set<u64> adapters = loadAdapters(file);
+	Common::MappedFile file{path};
+	assert(file.isOpen());
+	std::set<u64> adapters = loadAdapters(file.getContent());
+	Common::markParsed(adapters.size());
 	assert(adapters.empty() == false);
 
 	u64 deviceJolt = *adapters.rbegin() + 3;
@@ -138,9 +138,27 @@ void part2()
 		}
 	}
 
-	auto pathCount = getNumberofPaths(graph);
+	return getNumberofPaths(graph);
+}
+
+void part2()
+{
+	std::filesystem::path path{std::filesystem::current_path().parent_path()};
+	path += "/data/PuzzleInput/Day10/input.txt";
+	//path += "/data/PuzzleInput/Day10/test";
+	//path += "/data/PuzzleInput/Day10/test2";
+	auto pathCount = getAnswerPart2(path);
 	std::cout << "part2: " << pathCount << "\n"; // 16198260678656
 	int debug = 123;
 }
 
+static const Common::Registration registration{
+	{10, 1, "Day10/input.txt", getAnswerPart1},
+	{10, 1, "Day10/test", getAnswerPart1},
+	{10, 1, "Day10/test2", getAnswerPart1},
+	{10, 2, "Day10/input.txt", getAnswerPart2},
+	{10, 2, "Day10/test", getAnswerPart2},
+	{10, 2, "Day10/test2", getAnswerPart2},
+};
+
 }
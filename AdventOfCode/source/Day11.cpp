@@ -1,3 +1,8 @@
+#include "Common/Benchmark.hh"
+#include "Common/Input.hh"
+#include "Common/Registry.hh"
+#include "Common/Trace.hh"
+
 #include <cassert>
 
 #include <algorithm>
@@ -10,6 +15,7 @@
 #include <set>
 #include <string>
 #include <sstream>
+#include <string_view>
 #include <vector>
 
 namespace Day11
@@ -219,12 +225,12 @@ State State::nextStepPart2() const
     return newState;
 }
 
-State loadState(std::istream& stream)
+State loadState(std::string_view input)
 {
     State state;
-    for(std::string line; std::getline(stream, line);)
+    for(std::string_view line : Common::Lines{input})
     {
-        state.seats.push_back(line);
+        state.seats.emplace_back(line);
     }
     return state;
 }
@@ -246,15 +252,47 @@ bool operator==(const State& lhs, const State& rhs)
     return true;
 }
 
+u64 countOccupiedWhenStable(State state, State (State::*nextStep)() const)
+{
+    for(;;)
+    {
+        AOC_TRACE_SCOPE("State::nextStep");
+        State newState = (state.*nextStep)();
+        if(newState == state)
+        {
+            return newState.countOccupied();
+        }
+        state = std::move(newState);
+    }
+}
+
+u64 getAnswerPart1(const std::filesystem::path& path)
+{
+    Common::MappedFile file{path};
+    assert(file.isOpen());
+    State state = loadState(file.getContent());
+    Common::markParsed(state.seats.size());
+    return countOccupiedWhenStable(std::move(state), &State::nextStepPart1);
+}
+
+u64 getAnswerPart2(const std::filesystem::path& path)
+{
+    Common::MappedFile file{path};
+    assert(file.isOpen());
+    State state = loadState(file.getContent());
+    Common::markParsed(state.seats.size());
+    return countOccupiedWhenStable(std::move(state), &State::nextStepPart2);
+}
+
 void part1()
 {
     std::filesystem::path path{std::filesystem::current_path().parent_path()};
     path += "/data/PuzzleInput/Day11/input.txt";
     //path += "/data/PuzzleInput/Day11/test";
     //path += "/data/PuzzleInput/Day11/test2";
-    std::ifstream file{path};
-    assert(file);
-    State state = loadState(file);
+    Common::MappedFile file{path};
+    assert(file.isOpen());
+    State state = loadState(file.getContent());
 
     std::vector<State> states{state};
     for(;;)
@@ -274,4 +312,11 @@ void part1()
     int debug = 123;
 }
 
+static const Common::Registration registration{
+    {11, 1, "Day11/input.txt", getAnswerPart1},
+    {11, 1, "Day11/test", getAnswerPart1},
+    {11, 2, "Day11/input.txt", getAnswerPart2},
+    {11, 2, "Day11/test", getAnswerPart2},
+};
+
 }
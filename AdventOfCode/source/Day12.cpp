@@ -1,3 +1,8 @@
+#include "Common/Benchmark.hh"
+#include "Common/Input.hh"
+#include "Common/Parse.hh"
+#include "Common/Registry.hh"
+
 #include <cassert>
 #define _USE_MATH_DEFINES
 #include <cmath>
@@ -11,6 +16,7 @@
 #include <numeric>
 #include <set>
 #include <string>
+#include <string_view>
 #include <sstream>
 #include <vector>
 
@@ -57,15 +63,14 @@ bool Instruction::isTurn() const
 
 using Instructions = std::vector<Instruction>;
 
-Instructions loadInstructions(std::istream& stream)
+Instructions loadInstructions(std::string_view input)
 {
     Instructions result;
-    for(std::string line; std::getline(stream, line);)
+    for(std::string_view line : Common::Lines{input})
     {        
         Instruction instruction;
         instruction.action = line[0];
-        std::stringstream ss{line.substr(1)};
-        ss >> instruction.value;
+        instruction.value = Common::toNumber<Number>(line.substr(1));
         result.push_back(instruction);
     }
     return result;
@@ -177,7 +182,7 @@ Where& Where::rotatePoint(Instruction instruction)
 Where& Where::move(Instruction instruction)
 {
     assert(instruction.isMove());
-    Direction offsetDirection = instruction.action == 'F' ? direction : DIRECTION_MAPPING[instruction.action];
+    Direction offsetDirection = instruction.action == 'F' ? direction : DIRECTION_MAPPING.at(instruction.action);
     Point offset{offsetDirection * instruction.value};
 
     position += offset;
@@ -216,9 +221,10 @@ void test()
 
 std::uint64_t getAnswerPart1(const std::filesystem::path& path)
 {
-    std::ifstream file{path};
-    assert(file);
-    Instructions instructions = loadInstructions(file);
+    Common::MappedFile file{path};
+    assert(file.isOpen());
+    Instructions instructions = loadInstructions(file.getContent());
+    Common::markParsed(instructions.size());
 
     Where where;
     for(const Instruction& instruction : instructions)
@@ -251,9 +257,10 @@ void part1()
 
 std::uint64_t getAnswerPart2(const std::filesystem::path& path)
 {
-    std::ifstream file{path};
-    assert(file);
-    Instructions instructions = loadInstructions(file);
+    Common::MappedFile file{path};
+    assert(file.isOpen());
+    Instructions instructions = loadInstructions(file.getContent());
+    Common::markParsed(instructions.size());
 
     Point waypointOffset{(10 * EAST + 1 * NORTH)};
 
@@ -303,4 +310,11 @@ void part2()
     Number debug = 123;
 }
 
+static const Common::Registration registration{
+    {12, 1, "Day12/input.txt", getAnswerPart1},
+    {12, 1, "Day12/test", getAnswerPart1},
+    {12, 2, "Day12/input.txt", getAnswerPart2},
+    {12, 2, "Day12/test", getAnswerPart2},
+};
+
 }
@@ -1,3 +1,8 @@
+#include "Common/Benchmark.hh"
+#include "Common/Input.hh"
+#include "Common/Parse.hh"
+#include "Common/Registry.hh"
+
 #include <cassert>
 #define _USE_MATH_DEFINES
 #include <cmath>
@@ -5,13 +10,13 @@
 #include <algorithm>
 #include <filesystem>
 #include <functional>
-#include <fstream>
 #include <iostream>
+#include <limits>
 #include <map>
 #include <numeric>
 #include <set>
 #include <string>
-#include <sstream>
+#include <string_view>
 #include <vector>
 
 namespace Day13
@@ -25,39 +30,39 @@ struct DepartureData
     std::vector<Number> busIds;
 };
 
-DepartureData load(std::istream& stream)
+// Takes the next line off input, which the schedule must still have.
+std::string_view takeLine(std::string_view& input)
+{
+    std::string_view line;
+    if(Common::nextLine(input, line, 0) == false)
+    {
+        throw Common::ParseError{"the schedule needs two lines"};
+    }
+    return line;
+}
+
+// "939" then "7,13,x,x,59,x,31,19"
+DepartureData load(std::string_view input)
 {
     DepartureData result;
-    stream >> result.earliest;
-    for(; stream;)
+    result.earliest = Common::toNumber<Number>(takeLine(input));
+    std::string_view line = takeLine(input);
+    for(std::string_view busId : Common::Tokens{line, ','})
     {
-        Number temp;
-        if(stream.peek() == 'x')
+        if(busId != "x")
         {
-            char dummy;
-            stream >> dummy;
-            assert(dummy == 'x');
+            result.busIds.push_back(Common::toNumber<Number>(busId));
         }
-        else
-        {
-            stream >> temp;
-            if(stream)
-            {
-                result.busIds.push_back(temp);
-            }
-        }        
-        char dummy = 0;
-        stream >> dummy;
-        assert(dummy == ',' || dummy == EOF || (bool)stream == false);
     }
     return result;
 }
 
 Number getAnswerPart1(const std::filesystem::path& path)
 {
-    std::ifstream file{path};
-    assert(file);
-    DepartureData departureData = load(file);
+    Common::MappedFile file{path};
+    assert(file.isOpen());
+    DepartureData departureData = load(file.getContent());
+    Common::markParsed(departureData.busIds.size());
 
     Number id = -1;
     Number diff = std::numeric_limits<Number>::max();
@@ -100,36 +105,24 @@ struct Data
     Number offset;
 };
 
-std::vector<Data> load2(std::istream& stream)
+std::vector<Data> load2(std::string_view input)
 {
     std::vector<Data> result;
 
-    Number dummy;
-    stream >> dummy;
+    takeLine(input);    // the earliest departure is not needed
+    std::string_view line = takeLine(input);
     Number offset = 0;
-    for(; stream; ++offset)
+    for(std::string_view busId : Common::Tokens{line, ','})
     {
-        if(stream.peek() == 'x')
-        {
-            char dummy;
-            stream >> dummy;
-            assert(dummy == 'x');
-        }
-        else
+        if(busId != "x")
         {
-            Number busId = -1;
-            stream >> busId;
-            if(stream)
-            {
-                result.push_back({busId, offset});
-            }
+            result.push_back({Common::toNumber<Number>(busId), offset});
         }
-        char dummy = 0;
-        stream >> dummy;
-        assert(dummy == ',' || dummy == EOF || (bool) stream == false);
+        ++offset;
     }
     return result;
 }
+
 bool check(Number t, const std::vector<Data>& data)
 {
     for(const Data& item : data)
@@ -173,9 +166,10 @@ Number doStuff(const std::vector<Data>& data)
 
 Number getAnswerPart2(const std::filesystem::path& path)
 {
-    std::ifstream file{path};
-    assert(file);
-    std::vector<Data> data = load2(file);
+    Common::MappedFile file{path};
+    assert(file.isOpen());
+    std::vector<Data> data = load2(file.getContent());
+    Common::markParsed(data.size());
 
     Number result = getBruteForceT(data);
     //Number result = doStuff(data);
@@ -200,4 +194,10 @@ void part2()
     int debug = 123;
 }
 
+// part2 is not registered: the brute force search does not finish in reasonable time
+static const Common::Registration registration{
+    {13, 1, "Day13/input.txt", getAnswerPart1},
+    {13, 1, "Day13/test", getAnswerPart1},
+};
+
 }
@@ -1,3 +1,9 @@
+#include "Common/Benchmark.hh"
+#include "Common/Input.hh"
+#include "Common/Parse.hh"
+#include "Common/Registry.hh"
+#include "Common/Trace.hh"
+
 #include <cassert>
 #define _USE_MATH_DEFINES
 #include <cmath>
@@ -6,14 +12,13 @@
 #include <bitset>
 #include <filesystem>
 #include <functional>
-#include <fstream>
 #include <iostream>
 #include <map>
 #include <numeric>
 #include <unordered_map>
 #include <set>
 #include <string>
-#include <sstream>
+#include <string_view>
 #include <vector>
 
 namespace Day14
@@ -105,33 +110,46 @@ void fill(std::string& value)
     value = result;
 }
 
-Data load(std::istream& stream)
+Data load(std::string_view input)
 {
     Data result;
-    for(std::string line; std::getline(stream, line);)
+    for(std::string_view line : Common::Lines{input})
     {
-        if(line.find("mask") != std::string::npos)
+        if(line.empty())
+        {
+            continue;
+        }
+        if(line.find("mask") != std::string_view::npos)
         {
-            const static std::string MASK_PREFIX = "mask = ";
-            std::string mask = line.substr(MASK_PREFIX.size());
-            assert(mask.size() == 36);
+            constexpr std::string_view MASK_PREFIX = "mask = ";
+            std::string mask{line.substr(std::min(MASK_PREFIX.size(), line.size()))};
+            if(mask.size() != 36 || mask.find_first_not_of("01X") != std::string::npos)
+            {
+                throw Common::ParseError{"malformed mask: " + std::string{line}};
+            }
             result.masks.push_back(std::move(mask));
             auto index = result.masks.size() - 1;
             result.program.push_back({Data::ProgramLine::Type::MASK, index});
 
         }
-        else if(line.find("mem") != std::string::npos)
+        else if(line.find("mem") != std::string_view::npos)
         {
             auto posOpen = line.find('[');
             auto posClose = line.find(']');
             auto posEqual = line.find('=');
-            std::string address = line.substr(posOpen + 1, posClose - posOpen - 1);
+            if(posOpen == std::string_view::npos || posClose == std::string_view::npos || posEqual == std::string_view::npos ||
+                posClose < posOpen || posEqual < posClose)
+            {
+                throw Common::ParseError{"malformed memory write: " + std::string{line}};
+            }
+            std::string_view addressText = line.substr(posOpen + 1, posClose - posOpen - 1);
+            Common::toNumber<std::uint64_t>(addressText);   // throws unless it is a number, which then fits 36 digits
+            std::string address{addressText};
             fill(address);
             assert(address.size() == 36);
-            auto remaining = line.substr(posEqual + 1);
-            std::stringstream ss(remaining);
-            std::uint64_t value = 0;
-            ss >> value;
+            std::string_view valueText = line.substr(posEqual + 1);
+            valueText.remove_prefix(std::min(valueText.find_first_not_of(' '), valueText.size()));
+            std::uint64_t value = Common::toNumber<std::uint64_t>(valueText);
 
             result.memory.push_back({address, value});
             auto index = result.memory.size() - 1;
@@ -139,7 +157,7 @@ Data load(std::istream& stream)
         }
         else
         {
-            assert(false);
+            throw Common::ParseError{"unknown instruction: " + std::string{line}};
         }
     }
     return result;
@@ -147,6 +165,7 @@ Data load(std::istream& stream)
 
 std::uint64_t run1(const Data& data)
 {
+    AOC_TRACE_SCOPE("run1");
     std::unordered_map<std::uint64_t, std::uint64_t> memory;
     Mask currentMask = Mask{};
 
@@ -162,7 +181,7 @@ std::uint64_t run1(const Data& data)
             case Data::ProgramLine::Type::MEMORY:
             {
                 const Data::MemoryEntry& memoryEntry = data.memory[programLine.index];
-                const std::uint64_t address = std::stoll(memoryEntry.address);
+                const std::uint64_t address = Common::toNumber<std::uint64_t>(memoryEntry.address);
                 memory[address] = currentMask.apply(memoryEntry.value);
             }
             break;
@@ -179,9 +198,10 @@ std::uint64_t run1(const Data& data)
 
 std::uint64_t getAnswer(const std::filesystem::path& path, std::function<std::uint64_t(const Data& data)> runFunc)
 {
-    std::ifstream file(path);
-    assert(file);
-    Data data = load(file);
+    Common::MappedFile file{path};
+    assert(file.isOpen());
+    Data data = load(file.getContent());
+    Common::markParsed(data.program.size());
 
     std::uint64_t result = runFunc(data);
     return result;
@@ -256,6 +276,7 @@ std::vector<std::uint64_t> decodeMemoryAddresses(const std::string& mask, const
 
 std::uint64_t run2(const Data& data)
 {
+    AOC_TRACE_SCOPE("run2");
     std::unordered_map<std::uint64_t, std::uint64_t> memory;
     std::string mask;
 
@@ -271,7 +292,7 @@ std::uint64_t run2(const Data& data)
             case Data::ProgramLine::Type::MEMORY:
             {
                 auto [address, value] = data.memory[programLine.index];
-                std::string addressBinary = std::bitset<36>(std::stoi(address)).to_string();
+                std::string addressBinary = std::bitset<36>(Common::toNumber<std::uint64_t>(address)).to_string();
                 std::vector<std::uint64_t> decodedAddresses = decodeMemoryAddresses(mask, addressBinary);
                 for(std::uint64_t decodedAddress : decodedAddresses)
                 {
@@ -335,4 +356,11 @@ void solve()
 }
 
 
+static const Common::Registration registration{
+    {14, 1, "Day14/input.txt", getAnswerPart1},
+    {14, 1, "Day14/test", getAnswerPart1},
+    {14, 2, "Day14/input.txt", getAnswerPart2},
+    {14, 2, "Day14/test2", getAnswerPart2},
+};
+
 }
@@ -1,3 +1,9 @@
+#include "Common/Benchmark.hh"
+#include "Common/Input.hh"
+#include "Common/Parse.hh"
+#include "Common/Registry.hh"
+#include "Common/Trace.hh"
+
 #include <cassert>
 #define _USE_MATH_DEFINES
 #include <cmath>
@@ -6,14 +12,13 @@
 #include <bitset>
 #include <filesystem>
 #include <functional>
-#include <fstream>
 #include <iostream>
 #include <map>
 #include <numeric>
 #include <unordered_map>
 #include <set>
 #include <string>
-#include <sstream>
+#include <string_view>
 #include <vector>
 
 namespace Day15
@@ -28,7 +33,7 @@ public:
     Number run(Number turnCount);
 
 private:
-    static std::vector<Number> load(std::istream& stream);
+    static std::vector<Number> load(std::string_view input);
     const std::filesystem::path initialNumbersPath;
     std::vector<Number> initialNumbers;
     
@@ -44,17 +49,13 @@ private:
     std::map<Number, Data> extendedHistory;
 };
 
-std::vector<Number> Game::load(std::istream& stream)
+std::vector<Number> Game::load(std::string_view input)
 {
+    AOC_TRACE_SCOPE("Game::load");
     std::vector<Number> result;
-    for(; stream;)
+    for(std::string_view number : Common::Tokens{input, ','})
     {
-        Number temp = 0;
-        stream >> temp;
-        result.push_back(temp);
-        char ignore;
-        stream >> ignore;
-        assert(ignore == ',' || ignore == EOF);
+        result.push_back(Common::toNumber<Number>(number));
     }
     return result;
 }
@@ -69,9 +70,11 @@ void Game::addNumber(Number number, Number turn)
 
 Number Game::run(Number turnCount)
 {
-    std::ifstream file{initialNumbersPath};
-    assert(file);
-    initialNumbers = load(file);
+    Common::MappedFile file{initialNumbersPath};
+    assert(file.isOpen());
+    initialNumbers = load(file.getContent());
+    Common::markParsed(initialNumbers.size());
+    AOC_TRACE_SCOPE("Game::play");
 
     Number turn = 1;
     for(auto number : initialNumbers)
@@ -156,4 +159,10 @@ void solve()
     int debug = 123;
 }
 
-}
\ No newline at end of file
+static const Common::Registration registration{
+    {15, 1, "Day15/input.txt", getAnswerPart1},
+    {15, 1, "Day15/test", getAnswerPart1},
+    {15, 2, "Day15/input.txt", getAnswerPart2},
+};
+
+}
@@ -1,3 +1,8 @@
+#include "Common/Benchmark.hh"
+#include "Common/Input.hh"
+#include "Common/Parse.hh"
+#include "Common/Registry.hh"
+
 #include <cassert>
 #define _USE_MATH_DEFINES
 #include <cmath>
@@ -6,14 +11,13 @@
 #include <bitset>
 #include <filesystem>
 #include <functional>
-#include <fstream>
 #include <iostream>
 #include <map>
 #include <numeric>
 #include <unordered_map>
 #include <set>
 #include <string>
-#include <sstream>
+#include <string_view>
 #include <vector>
 
 namespace Day16
@@ -39,14 +43,14 @@ struct Field
 
 struct Ticket
 {
-    static Ticket load(const std::string& line);
+    static Ticket load(std::string_view line);
 
     std::vector<Number> values;
 };
 
 struct Data
 {
-    static Data load(std::istream& stream);
+    static Data load(std::string_view input);
 
     bool isValid(Number value) const;
     bool isValid(const Ticket& ticket) const;
@@ -60,27 +64,22 @@ struct Data
     std::vector<Ticket> tickets;
 };
 
-Ticket Ticket::load(const std::string& line)
+Ticket Ticket::load(std::string_view line)
 {
-    std::stringstream ss{line};
-
     Ticket ticket;
-    for(std::string value; std::getline(ss, value, ',');)
-    {
-        ticket.values.push_back(std::stoll(value));
-    }
+    ticket.values = Common::parseNumbers<Number>(line);
     return ticket;
 }
 
-Data Data::load(std::istream& stream)
+Data Data::load(std::string_view input)
 {
-    static const std::string YOUR_TICKET_SEPARATOR = "your ticket:";
-    static const std::string NEARBY_TICKETS_SEPARATOR = "nearby tickets:";
+    static constexpr std::string_view YOUR_TICKET_SEPARATOR = "your ticket:";
+    static constexpr std::string_view NEARBY_TICKETS_SEPARATOR = "nearby tickets:";
 
     Data result;
     enum class State {FIELDS, OWN_TICKET, OTHER_TICKETS};
     State state = State::FIELDS;
-    for(std::string line; std::getline(stream, line);)
+    for(std::string_view line : Common::Lines{input})
     {
         if(line.empty())
             continue;
@@ -103,21 +102,15 @@ Data Data::load(std::istream& stream)
             {
                 Field field;
                 auto colonPos = line.find(':');
-                assert(colonPos != std::string::npos);
+                assert(colonPos != std::string_view::npos);
                 field.name = line.substr(0, colonPos);
-    
-                std::string remaining{line.substr(colonPos)};
-                std::string rangeStr;
-                for(std::stringstream ss{remaining}; std::getline(ss, rangeStr, 'o');)
+
+                // "1-3 or 5-7": the numbers pair up into ranges
+                std::vector<Number> bounds = Common::parseNumbers<Number>(line.substr(colonPos + 1));
+                assert(bounds.size() % 2 == 0);
+                for(std::size_t i = 0; i + 1 < bounds.size(); i += 2)
                 {
-                    std::stringstream rangeSs{rangeStr};
-                    Range range{0, 0};
-                    char dummy = 0;
-                    rangeSs >> dummy;
-                    rangeSs >> range.min;
-                    rangeSs >> dummy;
-                    rangeSs >> range.max;
-                    field.ranges.push_back(range);
+                    field.ranges.push_back(Range{bounds[i], bounds[i + 1]});
                 }
                 result.fields.push_back(std::move(field));
             }
@@ -190,9 +183,10 @@ Number Data::calculateErrorRate() const
 
 Number getAnswerPart1(const std::filesystem::path& path)
 {
-    std::ifstream file{path};
-    assert(file);
-    Data data = Data::load(file);
+    Common::MappedFile file{path};
+    assert(file.isOpen());
+    Data data = Data::load(file.getContent());
+    Common::markParsed(data.tickets.size());
 
     Number result = data.calculateErrorRate();
     return result;
@@ -285,9 +279,10 @@ Number Data::calculateFields()
 
 Number getAnswerPart2(const std::filesystem::path& path)
 {
-    std::ifstream file{path};
-    assert(file);
-    Data data = Data::load(file);
+    Common::MappedFile file{path};
+    assert(file.isOpen());
+    Data data = Data::load(file.getContent());
+    Common::markParsed(data.tickets.size());
 
     
 
@@ -323,4 +318,11 @@ void solve()
 
     int debug = 123;
 }
+
+static const Common::Registration registration{
+    {16, 1, "Day16/input.txt", getAnswerPart1},
+    {16, 1, "Day16/test", getAnswerPart1},
+    {16, 2, "Day16/input.txt", getAnswerPart2},
+};
+
 }
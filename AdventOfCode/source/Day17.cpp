@@ -1,3 +1,8 @@
+#include "Common/Benchmark.hh"
+#include "Common/Input.hh"
+#include "Common/Registry.hh"
+#include "Common/Trace.hh"
+
 #include <cassert>
 #define _USE_MATH_DEFINES
 #include <cmath>
@@ -6,14 +11,13 @@
 #include <bitset>
 #include <filesystem>
 #include <functional>
-#include <fstream>
 #include <iostream>
 #include <map>
 #include <numeric>
 #include <unordered_map>
 #include <set>
 #include <string>
-#include <sstream>
+#include <string_view>
 #include <tuple>
 #include <vector>
 
@@ -60,7 +64,7 @@ using SpaceData = std::map<Point, Status>;
 struct Space
 {
 public:
-    Space(std::istream& stream) :space{load(stream)} {}
+    explicit Space(std::string_view input) :space{load(input)} {}
     Number countActiveCubes() const;
     void run(int numSteps);
     static void print(const SpaceData& spaceData, std::ostream& stream);
@@ -68,7 +72,7 @@ public:
 private:
     static Boundary getBounds(const SpaceData& spaceData);
 
-    static std::map<Point, Status> load(std::istream& stream);
+    static std::map<Point, Status> load(std::string_view input);
 
     Status getStatusInNextStep(const Point& point, Status status) const;
 
@@ -82,15 +86,15 @@ private:
     SpaceData space;
 };
 
-std::map<Point, Status> Space::load(std::istream& stream)
+std::map<Point, Status> Space::load(std::string_view input)
 {
+    AOC_TRACE_SCOPE("Space::load");
     std::map<Point, Status> result;
 
     Coordinate x = 0;
     Coordinate y = 0;
     Coordinate z = 0;
-    std::string line;
-    for(y = 0; std::getline(stream, line); ++y)
+    for(std::string_view line : Common::Lines{input})
     {
         for(x = 0; x < line.size(); ++x)
         {
@@ -98,7 +102,8 @@ std::map<Point, Status> Space::load(std::istream& stream)
             Status status{line[static_cast<std::size_t>(x)]};
             auto [it, inserted] = result.insert({point, status});
             assert(inserted);
-        }        
+        }
+        ++y;
     }
     return result;
 }
@@ -194,6 +199,7 @@ void Space::print(const SpaceData& spaceData, std::ostream& stream)
 
 std::map<Point, Status> Space::createFrame() const
 {
+    AOC_TRACE_SCOPE("Space::createFrame");
     auto [min, max] = getBounds(space);
     auto [minX, minY, minZ] = min;
     auto [maxX, maxY, maxZ] = max;
@@ -259,6 +265,7 @@ Status Space::getStatusInNextStep(const Point& point, Status status) const
 
 std::map<Point, Status> Space::step() const
 {
+    AOC_TRACE_SCOPE("Space::step");
     auto framePoints = createFrame();
     auto spaceWithFrame{space};
     spaceWithFrame.insert(framePoints.begin(), framePoints.end());
@@ -298,16 +305,17 @@ Number Space::countActiveCubes() const
 
 Number getAnswerPart1(const std::filesystem::path& path)
 {
-    std::ifstream file{path};
-    assert(file);
-    Space space{file};
+    Common::MappedFile file{path};
+    assert(file.isOpen());
+    Space space{file.getContent()};
+    Common::markParsed(space.countActiveCubes());
     space.run(6);
 
     Number result = space.countActiveCubes();
     return result;
 }
 
-Number getAnswerPart2(const std::filesystem::path& path)
+Number getAnswerPart2(const std::filesystem::path&)
 {
     Number result = 0;
     return result;
@@ -344,4 +352,9 @@ void solve()
     int debug = 123;
 }
 
+static const Common::Registration registration{
+    {17, 1, "Day17/input.txt", getAnswerPart1},
+    {17, 1, "Day17/test", getAnswerPart1},
+};
+
 }
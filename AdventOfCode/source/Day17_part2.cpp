@@ -1,3 +1,8 @@
+#include "Common/Benchmark.hh"
+#include "Common/Input.hh"
+#include "Common/Registry.hh"
+#include "Common/Trace.hh"
+
 #include <cassert>
 #define _USE_MATH_DEFINES
 #include <cmath>
@@ -6,14 +11,13 @@
 #include <bitset>
 #include <filesystem>
 #include <functional>
-#include <fstream>
 #include <iostream>
 #include <map>
 #include <numeric>
 #include <unordered_map>
 #include <set>
 #include <string>
-#include <sstream>
+#include <string_view>
 #include <tuple>
 #include <vector>
 
@@ -61,7 +65,7 @@ using SpaceData = std::map<Point, Status>;
 struct Space
 {
 public:
-    Space(std::istream& stream) :space{load(stream)} {}
+    explicit Space(std::string_view input) :space{load(input)} {}
     Number countActiveCubes() const;
     void run(int numSteps);
     static void print(const SpaceData& spaceData, std::ostream& stream);
@@ -69,7 +73,7 @@ public:
 private:
     static Boundary getBounds(const SpaceData& spaceData);
 
-    static std::map<Point, Status> load(std::istream& stream);
+    static std::map<Point, Status> load(std::string_view input);
 
     Status getStatusInNextStep(const Point& point, Status status) const;
 
@@ -83,16 +87,16 @@ private:
     SpaceData space;
 };
 
-std::map<Point, Status> Space::load(std::istream& stream)
+std::map<Point, Status> Space::load(std::string_view input)
 {
+    AOC_TRACE_SCOPE("Space::load");
     std::map<Point, Status> result;
 
     Coordinate x = 0;
     Coordinate y = 0;
     Coordinate z = 0;
     Coordinate w = 0;
-    std::string line;
-    for(y = 0; std::getline(stream, line); ++y)
+    for(std::string_view line : Common::Lines{input})
     {
         for(x = 0; x < line.size(); ++x)
         {
@@ -100,7 +104,8 @@ std::map<Point, Status> Space::load(std::istream& stream)
             Status status{line[static_cast<std::size_t>(x)]};
             auto [it, inserted] = result.insert({point, status});
             assert(inserted);
-        }        
+        }
+        ++y;
     }
     return result;
 }
@@ -208,6 +213,7 @@ void Space::print(const SpaceData& spaceData, std::ostream& stream)
 
 std::map<Point, Status> Space::createFrame() const
 {
+    AOC_TRACE_SCOPE("Space::createFrame");
     auto [min, max] = getBounds(space);
     auto [minX, minY, minZ, minW] = min;
     auto [maxX, maxY, maxZ, maxW] = max;
@@ -297,6 +303,7 @@ Status Space::getStatusInNextStep(const Point& point, Status status) const
 
 std::map<Point, Status> Space::step() const
 {
+    AOC_TRACE_SCOPE("Space::step");
     auto framePoints = createFrame();
     auto spaceWithFrame{space};
     spaceWithFrame.insert(framePoints.begin(), framePoints.end());
@@ -316,7 +323,7 @@ void Space::run(int numSteps)
 {
     for(int i = 0; i < numSteps; ++i)
     {
-        std::cout << "cycle " << i << "\n";
+        //std::cout << "cycle " << i << "\n";
         //print(space, std::cout);
         auto next = step();
         space = std::move(next);
@@ -336,9 +343,10 @@ Number Space::countActiveCubes() const
 
 Number getAnswerPart2(const std::filesystem::path& path)
 {
-    std::ifstream file{path};
-    assert(file);
-    Space space{file};
+    Common::MappedFile file{path};
+    assert(file.isOpen());
+    Space space{file.getContent()};
+    Common::markParsed(space.countActiveCubes());
     space.run(6);
 
     Number result = space.countActiveCubes();
@@ -363,4 +371,9 @@ void solve()
     int debug = 123;
 }
 
+static const Common::Registration registration{
+    {17, 2, "Day17/input.txt", getAnswerPart2},
+    {17, 2, "Day17/test", getAnswerPart2},
+};
+
 }
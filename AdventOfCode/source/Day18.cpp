@@ -1,24 +1,13 @@
-#include "Day18/Parser.hh"
-#include "Day18/Recogniser.hh"
-#include "Day18/Shunting-yard.hh"
+#include "Common/Benchmark.hh"
+#include "Common/Input.hh"
+#include "Common/Parse.hh"
+#include "Common/Registry.hh"
 
 #include <cassert>
-#define _USE_MATH_DEFINES
-#include <cmath>
 
-#include <algorithm>
-#include <bitset>
 #include <filesystem>
-#include <functional>
-#include <fstream>
-#include <iostream>
-#include <map>
-#include <numeric>
-#include <unordered_map>
-#include <set>
 #include <string>
-#include <sstream>
-#include <tuple>
+#include <string_view>
 #include <vector>
 
 namespace Day18
@@ -26,102 +15,147 @@ namespace Day18
 
 using Number = std::uint64_t;
 
-std::vector<std::string> loadExpressions(std::istream& stream)
+// Binding strength of the two operators; both are left associative.
+struct Precedence
 {
-    std::vector<std::string> result;
-    for(std::string line; std::getline(stream, line);)
+    int add;
+    int multiply;
+};
+
+// Precedence climbing straight over the text of one expression: single pass, no tokens or
+// tree, and a recursion depth bounded by the nesting of the parentheses.
+struct Evaluator
+{
+public:
+    Evaluator(std::string_view expression, const Precedence& precedence) : expression{expression}, rest{expression}, precedence{precedence} {}
+
+    // Throws Common::ParseError when the expression is malformed.
+    Number evaluate();
+
+private:
+    Number evaluate(int minPrecedence);
+    Number evaluateOperand();
+
+    // The next character that is not a space, 0 at the end.
+    char peek();
+    [[noreturn]] void fail(const char* what) const;
+
+    std::string_view expression;
+    std::string_view rest;
+    Precedence precedence;
+};
+
+Number Evaluator::evaluate()
+{
+    const Number result = evaluate(0);
+    if(peek() != 0)
     {
-        result.push_back(line);
+        fail("unexpected character");
     }
     return result;
 }
 
-Number getAnswerPart1(const std::filesystem::path& path)
+Number Evaluator::evaluate(int minPrecedence)
 {
-    std::ifstream file{path};
-    assert(file);
-    Number result = 0;
-    return result;
+    Number result = evaluateOperand();
+    for(;;)
+    {
+        const char op = peek();
+        if(op != '+' && op != '*')
+        {
+            return result;
+        }
+        const int opPrecedence = op == '+' ? precedence.add : precedence.multiply;
+        if(opPrecedence < minPrecedence)
+        {
+            return result;
+        }
+        rest.remove_prefix(1);
+        const Number rhs = evaluate(opPrecedence + 1);
+        result = op == '+' ? result + rhs : result * rhs;
+    }
 }
 
-Number getAnswerPart2(const std::filesystem::path& path)
+Number Evaluator::evaluateOperand()
 {
-    std::ifstream file{path};
-    assert(file);
-    Number result = 0;
-    return result;
+    if(peek() == '(')
+    {
+        rest.remove_prefix(1);
+        const Number result = evaluate(0);
+        if(peek() != ')')
+        {
+            fail("missing ')'");
+        }
+        rest.remove_prefix(1);
+        return result;
+    }
+    Number value = 0;
+    if(Common::parseNumber(rest, value) == false)
+    {
+        fail("expected a number or '('");
+    }
+    return value;
 }
 
-void test()
+char Evaluator::peek()
 {
-    std::string line = "4 * 3 * (2 * 6 + (3 * 3 + 8 + 7 + 2) + 9 + 8) * 4 * 6";
-    auto i0 = std::stoi(line);
-
-    std::stringstream ss{line};
-    
-    int dummy = -1;
-    ss >> dummy;
-    char next = ss.peek();
-    ss >> std::ws;
-    next = ss.peek();
-
-    Recogniser{"1"}.recognise();
-    Recogniser{"(1)"}.recognise();
-    Recogniser{"1 + 2"}.recognise();
-    Recogniser{"1 + 2*3"}.recognise();
-    Recogniser{"1 + (2*3)"}.recognise();
-    Recogniser{line}.recognise();
-
-    assert(ShuntingYard{"2^3^4"}.transformToReversePolishNotation() == "2 3 4 ^ ^");
-    assert(ShuntingYard{"1 + 2 * 3"}.transformToReversePolishNotation() == "1 2 3 * +");
-    assert(ShuntingYard{"1 * 2 + 3"}.transformToReversePolishNotation() == "1 2 * 3 +");
-
-    auto rpn0 =
+    while(rest.empty() == false && rest.front() == ' ')
     {
-        ShuntingYard{"1"}.transformToReversePolishNotation(),
-        ShuntingYard{"(1)"}.transformToReversePolishNotation(),
-        ShuntingYard{"1 + 3"}.transformToReversePolishNotation(),
-        ShuntingYard{"1 + 3 * 4"}.transformToReversePolishNotation(),
-        ShuntingYard{"1 + (3 * 4)"}.transformToReversePolishNotation(),
-        ShuntingYard{"(1 + 3) * 4"}.transformToReversePolishNotation(),
-        ShuntingYard{"3 + 4 * 2 /(1-5)^2^3"}.transformToReversePolishNotation(),
-    };
-
-    auto d0 = Parser{"1"}.parse();
-    auto d1 = Parser{"(1)"}.parse();
-    auto d3 = Parser{"(1) + 2 * 3"}.parse();
-    auto d4 = Parser{"((1) + 2) * 3"}.parse();
-    int debug = 1234;
+        rest.remove_prefix(1);
+    }
+    return rest.empty() ? 0 : rest.front();
 }
 
-void solve()
+void Evaluator::fail(const char* what) const
 {
-    test();
-
-    std::filesystem::path inputPath{std::filesystem::current_path().parent_path()};
-    std::filesystem::path testPath{std::filesystem::current_path().parent_path()};
-    inputPath += "/data/PuzzleInput/Day18/input.txt";
-    testPath += "/data/PuzzleInput/Day18/test";
-
-    auto resultTest = getAnswerPart1(testPath);
-    std::cout << "test part1: " << resultTest << "\n";
-    assert(resultTest == 112);
-
-    auto resultInput = getAnswerPart1(inputPath);
-    std::cout << "real part1: " << resultInput << "\n";
-    assert(resultInput == 304);
-
+    const std::size_t column = expression.size() - rest.size() + 1;
+    throw Common::ParseError{std::string{what} + " at column " + std::to_string(column) + " of \"" + std::string{expression} + "\""};
+}
 
+std::vector<std::string_view> loadExpressions(std::string_view input)
+{
+    std::vector<std::string_view> result;
+    for(std::string_view line : Common::Lines{input})
+    {
+        if(line.empty() == false)
+        {
+            result.push_back(line);
+        }
+    }
+    return result;
+}
 
-    auto resultTest2 = getAnswerPart2(testPath);
-    std::cout << "test part2: " << resultTest2 << "\n";
-    //assert(resultTest2 == 208);
+Number sumExpressions(const std::filesystem::path& path, const Precedence& precedence)
+{
+    Common::MappedFile file{path};
+    assert(file.isOpen());
+    const std::vector<std::string_view> expressions = loadExpressions(file.getContent());
+    Common::markParsed(expressions.size());
+    Number result = 0;
+    for(std::string_view expression : expressions)
+    {
+        result += Evaluator{expression, precedence}.evaluate();
+    }
+    return result;
+}
 
-    auto resultInput2 = getAnswerPart2(inputPath);
-    std::cout << "real part2: " << resultInput2 << "\n";
-    //assert(resultInput2 == 3348493585827);
+// + and * bind equally, so an expression is evaluated left to right.
+Number getAnswerPart1(const std::filesystem::path& path)
+{
+    return sumExpressions(path, {1, 1});
+}
 
-    int debug = 123;
+// + binds tighter than *.
+Number getAnswerPart2(const std::filesystem::path& path)
+{
+    return sumExpressions(path, {2, 1});
 }
 
+static const Common::Registration registration{
+    {18, 1, "Day18/input.txt", getAnswerPart1},
+    {18, 1, "Day18/test", getAnswerPart1},
+    {18, 2, "Day18/input.txt", getAnswerPart2},
+    {18, 2, "Day18/test", getAnswerPart2},
+};
+
 }
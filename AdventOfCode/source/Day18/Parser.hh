@@ -2,6 +2,7 @@
 
 #include "Tokenizer.hh"
 
+#include <memory>
 #include <sstream>
 #include <stack>
 #include <string>
@@ -1,81 +1,41 @@
+#include "Common/Input.hh"
+#include "Common/Registry.hh"
+#include "Common/ThreadPool.hh"
+#include "Day2/Validator.hh"
+
 #include <cassert>
 
-#include <algorithm>
 #include <filesystem>
-#include <fstream>
 #include <iostream>
-#include <sstream>
-#include <string>
-#include <vector>
 
 namespace Day2
 {
-	struct Policy
-	{
-		int min;
-		int max;
-		char letter;
-	};
-
-	struct Line
+	std::uint64_t getAnswerPart1(const std::filesystem::path& path)
 	{
-		Policy policy;
-		std::string password;
-	};
-
-
-	std::vector<Line> load()
-	{
-		std::filesystem::path path{ std::filesystem::current_path().parent_path() };
-		path += "/data/PuzzleInput/Day2/input.txt";
-		std::ifstream file(path);
-		assert(file);
-
-		std::vector<Line> result;
-		for (std::string rawLine; std::getline(file, rawLine);)
-		{
-			char temp{ 0 };
-			std::istringstream ss(rawLine);
-			Line line;
-			ss >> line.policy.min;
-			ss >> temp;
-			assert(temp == '-');
-			ss >> line.policy.max;
-			ss >> line.policy.letter;
-			ss >> temp;
-			assert(temp == ':');
-			ss >> line.password;
-			result.push_back(line);
-		}
-
-		return result;
+		Common::MappedFile file{ path };
+		assert(file.isOpen());
+		// parsing and validating are one pass, so there is no separate parse phase to mark
+		return countValid(file.getContent(), Common::ThreadPool::instance(), Policies::OLD_SLED_RENTAL_PLACE).oldSledRentalPlace;
 	}
 
-	bool check_oldSledRentalPlace(const Line& line)
+	std::uint64_t getAnswerPart2(const std::filesystem::path& path)
 	{
-		auto count = std::count(line.password.begin(), line.password.end(), line.policy.letter);
-		return line.policy.min <= count && count <= line.policy.max;
-	}
-
-	bool check_new(const Line& line)
-	{
-		auto countMatchingChars = [](const std::string& password, int position, char letter)
-		{
-			return (password[position - 1] == letter) ? 1 : 0;
-		};
-		
-		return
-			countMatchingChars(line.password, line.policy.min, line.policy.letter) +
-			countMatchingChars(line.password, line.policy.max, line.policy.letter) == 1;
+		Common::MappedFile file{ path };
+		assert(file.isOpen());
+		return countValid(file.getContent(), Common::ThreadPool::instance(), Policies::NEW).new_;
 	}
 
 	void part1()
 	{
-		auto lines = load();
-		//auto result = std::count_if(lines.begin(), lines.end(), [](const Line& line) {return check_oldSledRentalPlace(line); });   // 620
-		auto result = std::count_if(lines.begin(), lines.end(), [](const Line& line) {return check_new(line); });					 // 727
+		std::filesystem::path path{ std::filesystem::current_path().parent_path() };
+		path += "/data/PuzzleInput/Day2/input.txt";
+		//auto result = getAnswerPart1(path);   // 620
+		auto result = getAnswerPart2(path);		// 727
 		std::cout << result << "\n"; 
 	}
-}
-
 
+	static const Common::Registration registration{
+		{ 2, 1, "Day2/input.txt", getAnswerPart1 },
+		{ 2, 2, "Day2/input.txt", getAnswerPart2 },
+	};
+}
@@ -0,0 +1,238 @@
+#include "Validator.hh"
+
+#include "Common/Cpu.hh"
+#include "Common/Input.hh"
+#include "Common/ThreadPool.hh"
+
+#include <cstring>
+
+#include <vector>
+
+namespace Day2
+{
+
+namespace
+{
+
+bool isDigit(char c)
+{
+    return static_cast<unsigned char>(c - '0') < 10;
+}
+
+// Reads at most MAX_POLICY_DIGITS digits, so a longer run is left behind as malformed input.
+constexpr std::ptrdiff_t MAX_POLICY_DIGITS = 4;
+
+int parseSmallNumber(const char*& it, const char* end)
+{
+    const char* last = end - it > MAX_POLICY_DIGITS ? it + MAX_POLICY_DIGITS : end;
+    int value = 0;
+    for(; it != last && isDigit(*it); ++it)
+        value = value * 10 + (*it - '0');
+    return value;
+}
+
+// Takes the next "1-3 a: abcde" line off [it, end), blank lines skipped. Stops at the first
+// line that does not match that format.
+bool nextLine(const char*& it, const char* end, Line& line)
+{
+    while(it != end && (*it == '\n' || *it == '\r'))
+        ++it;
+
+    const char* start = it;
+    line.policy.min = parseSmallNumber(it, end);
+    if(it == start || it == end || *it != '-')
+    {
+        it = end;
+        return false;
+    }
+    start = ++it;
+    line.policy.max = parseSmallNumber(it, end);
+    if(it == start || end - it < 4 || it[0] != ' ' || it[2] != ':' || it[3] != ' ')
+    {
+        it = end;
+        return false;
+    }
+    line.policy.letter = it[1];
+    it += 4;
+
+    const char* newline = static_cast<const char*>(std::memchr(it, '\n', static_cast<std::size_t>(end - it)));
+    const char* passwordEnd = newline != nullptr ? newline : end;
+    if(passwordEnd != it && passwordEnd[-1] == '\r')
+        --passwordEnd;
+    line.password = {it, static_cast<std::size_t>(passwordEnd - it)};
+    it = newline != nullptr ? newline + 1 : end;
+    return true;
+}
+
+std::size_t countLetterScalar(const char* it, const char* end, char letter)
+{
+    std::size_t count = 0;
+    for(; it != end; ++it)
+        count += *it == letter;
+    return count;
+}
+
+bool isInRange(const Policy& policy, std::size_t count)
+{
+    return static_cast<std::size_t>(policy.min) <= count && count <= static_cast<std::size_t>(policy.max);
+}
+
+bool countsOld(Policies policies)
+{
+    return policies != Policies::NEW;
+}
+
+bool countsNew(Policies policies)
+{
+    return policies != Policies::OLD_SLED_RENTAL_PLACE;
+}
+
+#ifdef AOC_X86
+
+constexpr std::ptrdiff_t LANES = 32;
+
+// Compares 32 bytes at a time and pops the match mask. A tail shorter than a vector is still
+// loaded whole when readableEnd allows it, e.g. the rest of the input after a password, and
+// the bytes past end are masked off.
+AOC_TARGET("avx2,popcnt")
+std::size_t countLetterAvx2(const char* it, const char* end, const char* readableEnd, char letter)
+{
+    const __m256i needle = _mm256_set1_epi8(letter);
+    std::size_t count = 0;
+    for(; end - it >= LANES; it += LANES)
+    {
+        const __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(it));
+        count += Common::popcount(static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(bytes, needle))));
+    }
+    if(it == end)
+        return count;
+    if(readableEnd - it < LANES)
+        return count + countLetterScalar(it, end, letter);
+
+    const __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(it));
+    const unsigned matches = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(bytes, needle)));
+    return count + Common::popcount(matches & ((1u << (end - it)) - 1));
+}
+
+// readableEnd lets the letter count load whole vectors past the end of a chunk. Only worth
+// it when the old policy, the one that counts letters, is among policies.
+AOC_TARGET("avx2,popcnt")
+ValidCounts countValidAvx2(const char* it, const char* end, const char* readableEnd, Policies policies)
+{
+    ValidCounts counts;
+    Line line;
+    while(nextLine(it, end, line))
+    {
+        const char* password = line.password.data();
+        counts.oldSledRentalPlace += isInRange(line.policy, countLetterAvx2(password, password + line.password.size(), readableEnd, line.policy.letter));
+        if(countsNew(policies))
+        {
+            counts.new_ += check_new(line);
+        }
+    }
+    return counts;
+}
+
+#endif
+
+}
+
+bool hasAvx2LetterCount()
+{
+    return Common::hasAvx2() && Common::hasPopcnt();
+}
+
+std::size_t countLetter(std::string_view text, char letter)
+{
+    const char* begin = text.data();
+    const char* end = begin + text.size();
+#ifdef AOC_X86
+    if(hasAvx2LetterCount())
+    {
+        return countLetterAvx2(begin, end, end, letter);
+    }
+#endif
+    return countLetterScalar(begin, end, letter);
+}
+
+bool check_oldSledRentalPlace(const Line& line)
+{
+    return isInRange(line.policy, countLetter(line.password, line.policy.letter));
+}
+
+bool check_new(const Line& line)
+{
+    auto countMatchingChars = [](std::string_view password, int position, char letter)
+    {
+        return static_cast<std::size_t>(position - 1) < password.size() && password[position - 1] == letter ? 1 : 0;
+    };
+
+    return
+        countMatchingChars(line.password, line.policy.min, line.policy.letter) +
+        countMatchingChars(line.password, line.policy.max, line.policy.letter) == 1;
+}
+
+ValidCounts& ValidCounts::operator+=(const ValidCounts& other)
+{
+    oldSledRentalPlace += other.oldSledRentalPlace;
+    new_ += other.new_;
+    return *this;
+}
+
+namespace
+{
+
+ValidCounts countValid(std::string_view input, const char* readableEnd, Policies policies)
+{
+    const char* it = input.data();
+    const char* end = it + input.size();
+#ifdef AOC_X86
+    if(countsOld(policies) && hasAvx2LetterCount())
+    {
+        return countValidAvx2(it, end, readableEnd, policies);
+    }
+#endif
+    ValidCounts counts;
+    Line line;
+    while(nextLine(it, end, line))
+    {
+        if(countsOld(policies))
+        {
+            counts.oldSledRentalPlace += isInRange(line.policy, countLetterScalar(line.password.data(), line.password.data() + line.password.size(), line.policy.letter));
+        }
+        if(countsNew(policies))
+        {
+            counts.new_ += check_new(line);
+        }
+    }
+    return counts;
+}
+
+}
+
+ValidCounts countValid(std::string_view input, Policies policies)
+{
+    return countValid(input, input.data() + input.size(), policies);
+}
+
+ValidCounts countValid(std::string_view input, Common::ThreadPool& pool, Policies policies)
+{
+    const std::vector<std::string_view> chunks = Common::splitLineChunks(input, Common::getNumChunks(input.size(), pool.getNumThreads()));
+    std::vector<ValidCounts> chunkCounts(chunks.size());
+    pool.parallelFor(0, chunks.size(), 1, [&](std::size_t begin, std::size_t end)
+    {
+        for(std::size_t i = begin; i < end; ++i)
+        {
+            chunkCounts[i] = countValid(chunks[i], input.data() + input.size(), policies);
+        }
+    });
+
+    ValidCounts counts;
+    for(const ValidCounts& chunk : chunkCounts)
+    {
+        counts += chunk;
+    }
+    return counts;
+}
+
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <string_view>
+
+namespace Common
+{
+struct ThreadPool;
+}
+
+namespace Day2
+{
+
+struct Policy
+{
+    int min;
+    int max;
+    char letter;
+};
+
+// "1-3 a: abcde"; the password points into the input
+struct Line
+{
+    Policy policy;
+    std::string_view password;
+};
+
+// Counts letter in text, 32 bytes per step with AVX2 when the CPU has it.
+std::size_t countLetter(std::string_view text, char letter);
+bool hasAvx2LetterCount();
+
+bool check_oldSledRentalPlace(const Line& line);
+bool check_new(const Line& line);
+
+struct ValidCounts
+{
+    std::uint64_t oldSledRentalPlace = 0;
+    std::uint64_t new_ = 0;
+
+    ValidCounts& operator+=(const ValidCounts& other);
+};
+
+// Which counts of ValidCounts countValid fills in; the other one stays 0. Only the old policy
+// needs the letters of the password counted, so the new one alone is much cheaper.
+enum class Policies { OLD_SLED_RENTAL_PLACE, NEW, BOTH };
+
+// Valid passwords under the policies, counted in one pass straight off the input: lines are
+// parsed in place and never stored.
+ValidCounts countValid(std::string_view input, Policies policies = Policies::BOTH);
+// Same, on chunks of the input cut at line ends and spread over the pool.
+ValidCounts countValid(std::string_view input, Common::ThreadPool& pool, Policies policies = Policies::BOTH);
+
+}
@@ -0,0 +1,103 @@
+#include "SlopeSweep.hh"
+
+#include "Common/ThreadPool.hh"
+
+#include <cassert>
+
+#include <algorithm>
+
+namespace Day3
+{
+
+namespace
+{
+
+constexpr std::size_t BLOCK_BYTES = 256 * 1024;
+constexpr std::size_t TASKS_PER_THREAD = 4;
+
+// Trees the slope meets on rows [begin, end): the first row it lands on in the block and its
+// column there are computed once, after that it steps as in countTrees.
+std::uint64_t countTreesInRows(const TreeMap& map, std::size_t right, std::size_t down, std::size_t begin, std::size_t end)
+{
+    const std::size_t width = map.getWidth();
+    const std::size_t step = (begin + down - 1) / down;
+    std::size_t column = (step % width) * right % width;
+    std::uint64_t count = 0;
+    for(std::size_t row = step * down; row < end; row += down)
+    {
+        count += map.isTree(row, column);
+        column += right;
+        if(column >= width)
+        {
+            column -= width;
+        }
+    }
+    return count;
+}
+
+}
+
+SlopeSweep sweepSlopes(const TreeMap& map, const Coord& maxSlope, Common::ThreadPool& pool)
+{
+    assert(maxSlope.right >= 0 && maxSlope.down >= 1);
+    SlopeSweep sweep;
+    sweep.maxSlope = maxSlope;
+    const std::size_t numRights = static_cast<std::size_t>(maxSlope.right) + 1;
+    const std::size_t numSlopes = numRights * static_cast<std::size_t>(maxSlope.down);
+    sweep.trees.assign(numSlopes, 0);
+    if(map.getWidth() == 0 || map.getHeight() == 0)
+    {
+        return sweep;
+    }
+
+    const std::size_t rowBytes = (map.getWidth() + 63) / 64 * sizeof(std::uint64_t);
+    const std::size_t rowsPerBlock = std::max<std::size_t>(BLOCK_BYTES / rowBytes, 1);
+    const std::size_t numBlocks = (map.getHeight() + rowsPerBlock - 1) / rowsPerBlock;
+    // split the slopes too when there are fewer row blocks than the pool can keep busy
+    const std::size_t wantedTasks = pool.getNumThreads() * TASKS_PER_THREAD;
+    const std::size_t numGroups = std::clamp<std::size_t>((wantedTasks + numBlocks - 1) / numBlocks, 1, numSlopes);
+    const std::size_t slopesPerGroup = (numSlopes + numGroups - 1) / numGroups;
+
+    std::vector<std::uint64_t> blockTrees(numBlocks * numSlopes, 0);
+    pool.parallelFor(0, numBlocks * numGroups, 1, [&](std::size_t taskBegin, std::size_t taskEnd)
+    {
+        for(std::size_t task = taskBegin; task < taskEnd; ++task)
+        {
+            const std::size_t block = task / numGroups;
+            const std::size_t group = task % numGroups;
+            const std::size_t rowBegin = block * rowsPerBlock;
+            const std::size_t rowEnd = std::min(rowBegin + rowsPerBlock, map.getHeight());
+            const std::size_t slopeEnd = std::min((group + 1) * slopesPerGroup, numSlopes);
+            std::uint64_t* trees = blockTrees.data() + block * numSlopes;
+            for(std::size_t slope = group * slopesPerGroup; slope < slopeEnd; ++slope)
+            {
+                const std::size_t right = slope % numRights % map.getWidth();
+                const std::size_t down = slope / numRights + 1;
+                trees[slope] = countTreesInRows(map, right, down, rowBegin, rowEnd);
+            }
+        }
+    });
+
+    for(std::size_t block = 0; block < numBlocks; ++block)
+    {
+        for(std::size_t slope = 0; slope < numSlopes; ++slope)
+        {
+            sweep.trees[slope] += blockTrees[block * numSlopes + slope];
+        }
+    }
+
+    auto toCoord = [numRights](std::size_t slope)
+    {
+        return Coord{static_cast<int>(slope % numRights), static_cast<int>(slope / numRights + 1)};
+    };
+    sweep.fewestTrees = toCoord(static_cast<std::size_t>(std::min_element(sweep.trees.begin(), sweep.trees.end()) - sweep.trees.begin()));
+    sweep.mostTrees = toCoord(static_cast<std::size_t>(std::max_element(sweep.trees.begin(), sweep.trees.end()) - sweep.trees.begin()));
+    return sweep;
+}
+
+SlopeSweep sweepSlopes(const TreeMap& map, const Coord& maxSlope)
+{
+    return sweepSlopes(map, maxSlope, Common::ThreadPool::instance());
+}
+
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "TreeMap.hh"
+
+#include <cstdint>
+
+#include <vector>
+
+namespace Common
+{
+struct ThreadPool;
+}
+
+namespace Day3
+{
+
+// Trees met on every slope with 0 <= right <= maxSlope.right and 1 <= down <= maxSlope.down.
+struct SlopeSweep
+{
+public:
+    std::uint64_t getTrees(const Coord& slope) const
+    {
+        return trees[static_cast<std::size_t>(slope.down - 1) * (maxSlope.right + 1) + slope.right];
+    }
+
+    Coord maxSlope;
+    std::vector<std::uint64_t> trees;   // by down, then right
+    Coord fewestTrees;                  // the first slope in that order on ties
+    Coord mostTrees;
+};
+
+// The map is cut into blocks of rows that stay in cache while every slope crosses them, and
+// the (row block, group of slopes) pairs run in parallel on the pool.
+SlopeSweep sweepSlopes(const TreeMap& map, const Coord& maxSlope, Common::ThreadPool& pool);
+SlopeSweep sweepSlopes(const TreeMap& map, const Coord& maxSlope);     // on the shared pool
+
+}
@@ -0,0 +1,111 @@
+#include "TreeMap.hh"
+
+#include "Common/Input.hh"
+
+#include <cassert>
+#include <cstring>
+
+#include <algorithm>
+
+namespace Day3
+{
+
+namespace
+{
+
+// '#' is 0x23 and '.' is 0x2e: bit 3 is clear exactly for trees. The multiply gathers the
+// low bit of each of the 8 bytes into the top byte, first byte lowest.
+std::uint64_t packTrees(const char* squares)
+{
+    std::uint64_t bytes;
+    std::memcpy(&bytes, squares, sizeof(bytes));
+    const std::uint64_t trees = (~bytes >> 3) & 0x0101010101010101;
+    return (trees * 0x0102040810204080) >> 56;
+}
+
+}
+
+TreeMap TreeMap::load(std::string_view input)
+{
+    TreeMap map;
+    for(std::string_view line : Common::Lines{input})
+    {
+        if(line.empty())
+        {
+            continue;
+        }
+        if(map.height == 0)
+        {
+            map.width = line.size();
+            map.wordsPerRow = (map.width + 63) / 64;
+            map.bits.reserve((input.size() / (map.width + 1) + 1) * map.wordsPerRow);
+        }
+        assert(line.size() == map.width);
+        for(std::size_t word = 0; word < map.wordsPerRow; ++word)
+        {
+            const std::size_t begin = word * 64;
+            const std::size_t end = std::min(begin + 64, map.width);
+            std::uint64_t bits = 0;
+            std::size_t column = begin;
+            for(; column + 8 <= end; column += 8)
+            {
+                bits |= packTrees(line.data() + column) << (column - begin);
+            }
+            for(; column < end; ++column)
+            {
+                bits |= static_cast<std::uint64_t>(line[column] == TREE) << (column - begin);
+            }
+            map.bits.push_back(bits);
+        }
+        ++map.height;
+    }
+    return map;
+}
+
+std::vector<std::uint64_t> countTrees(const TreeMap& map, const std::vector<Coord>& slopes)
+{
+    struct Walker
+    {
+        std::size_t right = 0;
+        std::size_t down = 0;
+        std::size_t row = 0;
+        std::size_t column = 0;
+    };
+
+    std::vector<std::uint64_t> counts(slopes.size(), 0);
+    if(map.getWidth() == 0)
+    {
+        return counts;
+    }
+
+    std::vector<Walker> walkers;
+    walkers.reserve(slopes.size());
+    for(const Coord& slope : slopes)
+    {
+        assert(slope.right >= 0 && slope.down > 0);
+        // reduced once here, so a single subtraction wraps every step
+        walkers.push_back({static_cast<std::size_t>(slope.right) % map.getWidth(), static_cast<std::size_t>(slope.down), 0, 0});
+    }
+
+    for(std::size_t row = 0; row < map.getHeight(); ++row)
+    {
+        for(std::size_t i = 0; i < walkers.size(); ++i)
+        {
+            Walker& walker = walkers[i];
+            if(walker.row != row)
+            {
+                continue;
+            }
+            counts[i] += map.isTree(row, walker.column);
+            walker.row += walker.down;
+            walker.column += walker.right;
+            if(walker.column >= map.getWidth())
+            {
+                walker.column -= map.getWidth();
+            }
+        }
+    }
+    return counts;
+}
+
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <string_view>
+#include <vector>
+
+namespace Day3
+{
+
+struct Coord
+{
+    int right = 0;
+    int down = 0;
+};
+
+// The map with one bit per square, set for a tree; each row starts on a fresh 64-bit word.
+// The pattern repeats to the right, so columns wrap at getWidth().
+struct TreeMap
+{
+public:
+    constexpr static char EMPTY = '.';
+    constexpr static char TREE = '#';
+
+    static TreeMap load(std::string_view input);
+
+    std::size_t getWidth() const { return width; }
+    std::size_t getHeight() const { return height; }
+
+    bool isTree(std::size_t row, std::size_t column) const
+    {
+        return (bits[row * wordsPerRow + column / 64] >> (column % 64)) & 1;
+    }
+
+private:
+    std::size_t width = 0;
+    std::size_t height = 0;
+    std::size_t wordsPerRow = 0;
+    std::vector<std::uint64_t> bits;
+};
+
+// Trees met on every slope from the top left corner, in the order of slopes. All slopes walk
+// down the map together, so each row is visited once however many slopes there are, and the
+// columns wrap by subtracting the width rather than with a modulo per step.
+std::vector<std::uint64_t> countTrees(const TreeMap& map, const std::vector<Coord>& slopes);
+
+}
@@ -0,0 +1,111 @@
+#include "Passports.hh"
+#include "Validators.hh"
+
+#include "Common/Input.hh"
+
+#include <algorithm>
+
+namespace Day4
+{
+
+namespace
+{
+
+constexpr std::uint32_t FIELD_HASH_MULTIPLIER = 0xf6a07501;
+
+constexpr std::uint32_t getKey(std::string_view name)
+{
+    return static_cast<std::uint32_t>(static_cast<unsigned char>(name[0]))
+        | static_cast<std::uint32_t>(static_cast<unsigned char>(name[1])) << 8
+        | static_cast<std::uint32_t>(static_cast<unsigned char>(name[2])) << 16;
+}
+
+constexpr std::size_t getSlot(std::uint32_t key)
+{
+    return static_cast<std::uint32_t>(key * FIELD_HASH_MULTIPLIER) >> 29;
+}
+
+struct FieldSlot
+{
+    std::uint32_t key = 0;
+    Field field = Field::NUM;
+};
+
+constexpr std::array<FieldSlot, NUM_FIELDS> makeFieldSlots()
+{
+    std::array<FieldSlot, NUM_FIELDS> slots{};
+    for(std::size_t i = 0; i < NUM_FIELDS; ++i)
+    {
+        const std::uint32_t key = getKey(FIELD_NAMES[i]);
+        slots[getSlot(key)] = {key, static_cast<Field>(i)};
+    }
+    return slots;
+}
+
+constexpr std::array<FieldSlot, NUM_FIELDS> FIELD_SLOTS = makeFieldSlots();
+
+constexpr bool isPerfect()
+{
+    for(const FieldSlot& slot : FIELD_SLOTS)
+    {
+        if(slot.field == Field::NUM)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+static_assert(isPerfect(), "FIELD_HASH_MULTIPLIER must map every field name to its own slot");
+
+}
+
+Field findField(std::string_view name)
+{
+    if(name.size() != 3)
+    {
+        return Field::NUM;
+    }
+    const std::uint32_t key = getKey(name);
+    const FieldSlot& slot = FIELD_SLOTS[getSlot(key)];
+    return slot.key == key ? slot.field : Field::NUM;
+}
+
+PassportTable PassportTable::parse(std::string_view input)
+{
+    PassportTable table;
+    for(std::string_view record : Common::Records{input})
+    {
+        for(std::vector<std::string_view>& column : table.values)
+        {
+            column.emplace_back();
+        }
+        FieldMask fields = 0;
+        for(std::string_view token : Common::Tokens{record})
+        {
+            const Field field = findField(token.substr(0, token.find(':')));
+            if(field == Field::NUM)
+            {
+                continue;
+            }
+            table.values[static_cast<std::size_t>(field)].back() = token.substr(std::min<std::size_t>(4, token.size()));
+            fields |= getBit(field);
+        }
+        table.fields.push_back(fields);
+    }
+    return table;
+}
+
+bool PassportTable::isValid(std::size_t passport) const
+{
+    if(hasAllRequiredFields(passport) == false)
+        return false;
+
+    bool result = true;
+    for(std::size_t field = 0; field < NUM_FIELDS; ++field)
+    {
+        result &= isValidField(static_cast<Field>(field), values[field][passport]);
+    }
+    return result;
+}
+
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <array>
+#include <string_view>
+#include <vector>
+
+namespace Day4
+{
+
+enum class Field : std::uint8_t
+{
+    BYR,
+    IYR,
+    EYR,
+    HGT,
+    HCL,
+    ECL,
+    PID,
+    CID,
+    NUM
+};
+constexpr std::size_t NUM_FIELDS = static_cast<std::size_t>(Field::NUM);
+constexpr std::array<std::string_view, NUM_FIELDS> FIELD_NAMES = {"byr", "iyr", "eyr", "hgt", "hcl", "ecl", "pid", "cid"};
+
+// One bit per Field present in a passport.
+using FieldMask = std::uint8_t;
+constexpr FieldMask getBit(Field field) { return static_cast<FieldMask>(1u << static_cast<unsigned>(field)); }
+constexpr FieldMask REQUIRED_FIELDS = static_cast<FieldMask>(((1u << NUM_FIELDS) - 1) & ~getBit(Field::CID));
+
+// The Field named by a 3 letter key, Field::NUM for anything else. A multiplicative hash of
+// the three letters is perfect and minimal over the eight names, so this is one multiply, a
+// table lookup and one compare to reject unknown keys.
+Field findField(std::string_view name);
+
+// The passports of a batch file, column per field. The values point into the input, which
+// must outlive the table; a field that is missing has an empty value and a clear bit.
+struct PassportTable
+{
+public:
+    static PassportTable parse(std::string_view input);
+
+    std::size_t size() const { return fields.size(); }
+    FieldMask getFields(std::size_t passport) const { return fields[passport]; }
+    std::string_view get(std::size_t passport, Field field) const { return values[static_cast<std::size_t>(field)][passport]; }
+    const std::vector<std::string_view>& getColumn(Field field) const { return values[static_cast<std::size_t>(field)]; }
+
+    bool hasAllRequiredFields(std::size_t passport) const { return (fields[passport] & REQUIRED_FIELDS) == REQUIRED_FIELDS; }
+    bool isValid(std::size_t passport) const;
+
+private:
+    std::array<std::vector<std::string_view>, NUM_FIELDS> values;
+    std::vector<FieldMask> fields;
+};
+
+}
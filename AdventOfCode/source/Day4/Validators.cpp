@@ -0,0 +1,466 @@
+#include "Validators.hh"
+
+#include "Common/Cpu.hh"
+#include "Common/Input.hh"
+#include "Common/ThreadPool.hh"
+
+#include <cstring>
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+namespace Day4
+{
+
+namespace
+{
+
+constexpr std::size_t BATCH_SIZE = 256;
+
+constexpr std::uint64_t ONES = 0x0101010101010101;
+constexpr std::uint64_t HIGH = 0x8080808080808080;
+
+// The first size bytes at data, first byte lowest.
+template<std::size_t size>
+std::uint64_t load(const char* data)
+{
+    std::uint64_t bytes = 0;
+    std::memcpy(&bytes, data, size);
+    return bytes;
+}
+
+// The high bit of every byte of bytes in [lo, hi]. Only meaningful when all bytes are ASCII,
+// which isAscii checks.
+constexpr std::uint64_t bytesInRange(std::uint64_t bytes, unsigned char lo, unsigned char hi)
+{
+    const std::uint64_t atLeastLo = ((bytes | HIGH) - ONES * lo) & HIGH;
+    const std::uint64_t atMostHi = ~(bytes + ONES * (0x7f - hi)) & HIGH;
+    return atLeastLo & atMostHi;
+}
+
+constexpr bool isAscii(std::uint64_t bytes)
+{
+    return (bytes & HIGH) == 0;
+}
+
+constexpr std::uint64_t getHighBits(std::size_t count)
+{
+    return count >= 8 ? HIGH : HIGH & ((std::uint64_t{1} << (8 * count)) - 1);
+}
+
+constexpr bool areDigits(std::uint64_t bytes, std::size_t count)
+{
+    const std::uint64_t mask = getHighBits(count);
+    return isAscii(bytes) & ((bytesInRange(bytes, '0', '9') & mask) == mask);
+}
+
+// The number written by the 4 digits of bytes, most significant first.
+constexpr std::uint32_t getNumber4(std::uint64_t bytes)
+{
+    std::uint64_t digits = (bytes & 0xffffffff) - 0x30303030;
+    digits = (digits * 10 + (digits >> 8)) & 0x00ff00ff;
+    return static_cast<std::uint32_t>((digits * 100 + (digits >> 16)) & 0xffff);
+}
+
+constexpr bool isInRange(std::uint32_t value, std::uint32_t min, std::uint32_t max)
+{
+    return value - min <= max - min;
+}
+
+constexpr std::uint32_t getKey(char a, char b, char c)
+{
+    return static_cast<std::uint32_t>(static_cast<unsigned char>(a))
+        | static_cast<std::uint32_t>(static_cast<unsigned char>(b)) << 8
+        | static_cast<std::uint32_t>(static_cast<unsigned char>(c)) << 16;
+}
+
+constexpr std::array<std::uint32_t, 7> EYE_COLORS = {
+    getKey('a', 'm', 'b'), getKey('b', 'l', 'u'), getKey('b', 'r', 'n'), getKey('g', 'r', 'y'),
+    getKey('g', 'r', 'n'), getKey('h', 'z', 'l'), getKey('o', 't', 'h'),
+};
+
+}
+
+bool isValidYear(std::string_view value, int min, int max)
+{
+    if(value.size() != 4)
+        return false;
+    const std::uint64_t bytes = load<4>(value.data());
+    return areDigits(bytes, 4) & isInRange(getNumber4(bytes), static_cast<std::uint32_t>(min), static_cast<std::uint32_t>(max));
+}
+
+bool isValidHeight(std::string_view value)
+{
+    if(value.size() != 4 && value.size() != 5)
+        return false;
+    // "193cm" or "76in": the digits are shifted up to fill 4 with leading zeros
+    const bool isCm = value.size() == 5;
+    const std::size_t numDigits = value.size() - 2;
+    const std::uint64_t digits = load<4>(value.data()) & ((std::uint64_t{1} << (8 * numDigits)) - 1);
+    const std::uint64_t padded = (digits << (8 * (4 - numDigits))) | (0x30303030 >> (8 * numDigits));
+    const std::uint32_t unit = static_cast<std::uint32_t>(load<2>(value.data() + numDigits));
+    const std::uint32_t number = getNumber4(padded);
+    const bool cm = isCm & (unit == getKey('c', 'm', 0)) & isInRange(number, 150, 193);
+    const bool in = !isCm & (unit == getKey('i', 'n', 0)) & isInRange(number, 59, 76);
+    return areDigits(padded, 4) & (cm | in);
+}
+
+bool isValidHairColor(std::string_view value)
+{
+    if(value.size() != 7)
+        return false;
+    constexpr std::uint64_t HEX_DIGITS = 0x0080808080808000;
+    const std::uint64_t bytes = load<7>(value.data());
+    const std::uint64_t hex = bytesInRange(bytes, '0', '9') | bytesInRange(bytes, 'a', 'f');
+    return isAscii(bytes) & ((bytes & 0xff) == '#') & ((hex & HEX_DIGITS) == HEX_DIGITS);
+}
+
+bool isValidEyeColor(std::string_view value)
+{
+    if(value.size() != 3)
+        return false;
+    const std::uint32_t key = static_cast<std::uint32_t>(load<3>(value.data()));
+    bool isColor = false;
+    for(std::uint32_t color : EYE_COLORS)
+    {
+        isColor |= key == color;
+    }
+    return isColor;
+}
+
+bool isValidPassportId(std::string_view value)
+{
+    if(value.size() != 9)
+        return false;
+    return areDigits(load<8>(value.data()), 8) & areDigits(load<1>(value.data() + 8), 1);
+}
+
+bool isValidField(Field field, std::string_view value)
+{
+    switch(field)
+    {
+        case Field::BYR:
+            return isValidYear(value, 1920, 2002);
+        case Field::IYR:
+            return isValidYear(value, 2010, 2020);
+        case Field::EYR:
+            return isValidYear(value, 2020, 2030);
+        case Field::HGT:
+            return isValidHeight(value);
+        case Field::HCL:
+            return isValidHairColor(value);
+        case Field::ECL:
+            return isValidEyeColor(value);
+        case Field::PID:
+            return isValidPassportId(value);
+        default:
+            return true;
+    }
+}
+
+namespace
+{
+
+// The columns of the required fields.
+struct Columns
+{
+    explicit Columns(const PassportTable& passports)
+        : byr{passports.getColumn(Field::BYR).data()}
+        , iyr{passports.getColumn(Field::IYR).data()}
+        , eyr{passports.getColumn(Field::EYR).data()}
+        , hgt{passports.getColumn(Field::HGT).data()}
+        , hcl{passports.getColumn(Field::HCL).data()}
+        , ecl{passports.getColumn(Field::ECL).data()}
+        , pid{passports.getColumn(Field::PID).data()}
+    {
+    }
+
+    const std::string_view* byr;
+    const std::string_view* iyr;
+    const std::string_view* eyr;
+    const std::string_view* hgt;
+    const std::string_view* hcl;
+    const std::string_view* ecl;
+    const std::string_view* pid;
+};
+
+bool isValid(const Columns& columns, std::size_t i)
+{
+    return isValidYear(columns.byr[i], 1920, 2002) & isValidYear(columns.iyr[i], 2010, 2020) & isValidYear(columns.eyr[i], 2020, 2030)
+        & isValidHeight(columns.hgt[i]) & isValidHairColor(columns.hcl[i]) & isValidEyeColor(columns.ecl[i])
+        & isValidPassportId(columns.pid[i]);
+}
+
+// Sums validate(candidates, numCandidates) over batches of the passports, where the candidates
+// are the passports of the batch that have every required field, compacted without a branch.
+template<typename Validate>
+std::uint64_t countCandidates(const PassportTable& passports, Validate validate)
+{
+    std::uint64_t result = 0;
+    std::array<std::uint32_t, BATCH_SIZE> candidates;
+    for(std::size_t begin = 0; begin < passports.size(); begin += BATCH_SIZE)
+    {
+        const std::size_t end = std::min(begin + BATCH_SIZE, passports.size());
+        std::size_t numCandidates = 0;
+        for(std::size_t i = begin; i < end; ++i)
+        {
+            candidates[numCandidates] = static_cast<std::uint32_t>(i);
+            numCandidates += passports.hasAllRequiredFields(i);
+        }
+        result += validate(candidates.data(), numCandidates);
+    }
+    return result;
+}
+
+#ifdef AOC_X86
+
+constexpr std::size_t LANES = 8;
+
+constexpr char ZEROS[4] = {};
+
+// The bytes of value from offset on when the value is exactly size long, zeros otherwise,
+// which no check accepts. Selecting the address rather than branching keeps the gather flat.
+template<std::size_t bytes>
+std::uint32_t loadIfSize(std::string_view value, std::size_t size, std::size_t offset = 0)
+{
+    return static_cast<std::uint32_t>(load<bytes>(value.size() == size ? value.data() + offset : ZEROS));
+}
+
+// The values of 8 passports cut into 32-bit words, one lane per passport.
+struct Lanes
+{
+    alignas(32) std::uint32_t byr[LANES];
+    alignas(32) std::uint32_t iyr[LANES];
+    alignas(32) std::uint32_t eyr[LANES];
+    alignas(32) std::uint32_t hgtDigits[LANES];     // the first 4 bytes of "193cm" or "76in"
+    alignas(32) std::uint32_t hgtUnit[LANES];       // the last 2
+    alignas(32) std::uint32_t hgtCm[LANES];         // all ones for 5 bytes, which must be cm
+    alignas(32) std::uint32_t hclHead[LANES];       // bytes 0-3 of "#123abc"
+    alignas(32) std::uint32_t hclTail[LANES];       // bytes 3-6
+    alignas(32) std::uint32_t ecl[LANES];
+    alignas(32) std::uint32_t pidHead[LANES];       // bytes 0-3, 4-7 and 5-8 of the 9 digits
+    alignas(32) std::uint32_t pidMiddle[LANES];
+    alignas(32) std::uint32_t pidTail[LANES];
+};
+
+void gather(Lanes& lanes, std::size_t lane, const Columns& columns, std::size_t i)
+{
+    lanes.byr[lane] = loadIfSize<4>(columns.byr[i], 4);
+    lanes.iyr[lane] = loadIfSize<4>(columns.iyr[i], 4);
+    lanes.eyr[lane] = loadIfSize<4>(columns.eyr[i], 4);
+
+    const std::string_view height = columns.hgt[i];
+    const bool isHeight = (height.size() == 4) | (height.size() == 5);
+    lanes.hgtDigits[lane] = static_cast<std::uint32_t>(load<4>(isHeight ? height.data() : ZEROS));
+    lanes.hgtUnit[lane] = static_cast<std::uint32_t>(load<2>(isHeight ? height.data() + height.size() - 2 : ZEROS));
+    lanes.hgtCm[lane] = 0u - static_cast<std::uint32_t>(height.size() == 5);
+
+    lanes.hclHead[lane] = loadIfSize<4>(columns.hcl[i], 7);
+    lanes.hclTail[lane] = loadIfSize<4>(columns.hcl[i], 7, 3);
+    lanes.ecl[lane] = loadIfSize<3>(columns.ecl[i], 3);
+    lanes.pidHead[lane] = loadIfSize<4>(columns.pid[i], 9);
+    lanes.pidMiddle[lane] = loadIfSize<4>(columns.pid[i], 9, 4);
+    lanes.pidTail[lane] = loadIfSize<4>(columns.pid[i], 9, 5);
+}
+
+AOC_TARGET("avx2")
+__m256i loadLanes(const std::uint32_t* words)
+{
+    return _mm256_load_si256(reinterpret_cast<const __m256i*>(words));
+}
+
+// All ones in every byte of bytes in [lo, hi].
+AOC_TARGET("avx2")
+__m256i bytesInRangeAvx2(__m256i bytes, char lo, char hi)
+{
+    const __m256i offset = _mm256_sub_epi8(bytes, _mm256_set1_epi8(lo));
+    return _mm256_cmpeq_epi8(_mm256_min_epu8(offset, _mm256_set1_epi8(static_cast<char>(hi - lo))), offset);
+}
+
+AOC_TARGET("avx2")
+__m256i isAllOnes(__m256i words)
+{
+    return _mm256_cmpeq_epi32(words, _mm256_set1_epi32(-1));
+}
+
+AOC_TARGET("avx2")
+__m256i areDigitsAvx2(__m256i words)
+{
+    return isAllOnes(bytesInRangeAvx2(words, '0', '9'));
+}
+
+// The number written by the 4 digits of each word: the first digit of each pair times 10
+// plus the second, then the first pair times 100 plus the second.
+AOC_TARGET("avx2")
+__m256i getNumber4Avx2(__m256i words)
+{
+    const __m256i digits = _mm256_sub_epi8(words, _mm256_set1_epi8('0'));
+    const __m256i pairs = _mm256_maddubs_epi16(digits, _mm256_set1_epi16(0x010a));
+    return _mm256_madd_epi16(pairs, _mm256_set1_epi32(0x00010064));
+}
+
+AOC_TARGET("avx2")
+__m256i isInRangeAvx2(__m256i values, __m256i min, __m256i max)
+{
+    return _mm256_andnot_si256(_mm256_or_si256(_mm256_cmpgt_epi32(min, values), _mm256_cmpgt_epi32(values, max)), _mm256_set1_epi32(-1));
+}
+
+AOC_TARGET("avx2")
+__m256i isValidYearAvx2(__m256i words, int min, int max)
+{
+    return _mm256_and_si256(areDigitsAvx2(words), isInRangeAvx2(getNumber4Avx2(words), _mm256_set1_epi32(min), _mm256_set1_epi32(max)));
+}
+
+// centimetres in the lanes where cm is set, inches in the others.
+AOC_TARGET("avx2")
+__m256i selectUnit(__m256i cm, int inches, int centimetres)
+{
+    return _mm256_blendv_epi8(_mm256_set1_epi32(inches), _mm256_set1_epi32(centimetres), cm);
+}
+
+// The digits are shifted up to fill 4 with leading zeros, as in isValidHeight, but by a
+// per lane amount.
+AOC_TARGET("avx2")
+__m256i isValidHeightAvx2(__m256i words, __m256i units, __m256i cm)
+{
+    const __m256i digits = _mm256_and_si256(words, selectUnit(cm, 0x0000ffff, 0x00ffffff));
+    const __m256i padded = _mm256_or_si256(_mm256_sllv_epi32(digits, selectUnit(cm, 16, 8)), selectUnit(cm, 0x3030, 0x30));
+    const __m256i unitOk = _mm256_cmpeq_epi32(units, selectUnit(cm, static_cast<int>(getKey('i', 'n', 0)), static_cast<int>(getKey('c', 'm', 0))));
+    return _mm256_and_si256(_mm256_and_si256(areDigitsAvx2(padded), unitOk), isInRangeAvx2(getNumber4Avx2(padded), selectUnit(cm, 59, 150), selectUnit(cm, 76, 193)));
+}
+
+AOC_TARGET("avx2")
+__m256i areHexDigitsAvx2(__m256i words)
+{
+    return _mm256_or_si256(bytesInRangeAvx2(words, '0', '9'), bytesInRangeAvx2(words, 'a', 'f'));
+}
+
+AOC_TARGET("avx2")
+__m256i isValidHairColorAvx2(__m256i head, __m256i tail)
+{
+    const __m256i hash = _mm256_and_si256(_mm256_cmpeq_epi8(head, _mm256_set1_epi8('#')), _mm256_set1_epi32(0xff));
+    const __m256i headOk = isAllOnes(_mm256_or_si256(_mm256_and_si256(areHexDigitsAvx2(head), _mm256_set1_epi32(~0xff)), hash));
+    return _mm256_and_si256(headOk, isAllOnes(areHexDigitsAvx2(tail)));
+}
+
+AOC_TARGET("avx2")
+__m256i isValidEyeColorAvx2(__m256i keys)
+{
+    __m256i isColor = _mm256_setzero_si256();
+    for(std::uint32_t color : EYE_COLORS)
+    {
+        isColor = _mm256_or_si256(isColor, _mm256_cmpeq_epi32(keys, _mm256_set1_epi32(static_cast<int>(color))));
+    }
+    return isColor;
+}
+
+// The scalar checkers, 8 passports at a time: the candidates are gathered into lanes, every
+// field is checked for all of them at once, and the last partial group goes through isValid.
+AOC_TARGET("avx2,popcnt")
+std::uint64_t countValidAvx2(const Columns& columns, const std::uint32_t* candidates, std::size_t numCandidates)
+{
+    std::uint64_t valid = 0;
+    Lanes lanes;
+    std::size_t candidate = 0;
+    for(; numCandidates - candidate >= LANES; candidate += LANES)
+    {
+        for(std::size_t lane = 0; lane < LANES; ++lane)
+        {
+            gather(lanes, lane, columns, candidates[candidate + lane]);
+        }
+        __m256i isValid = _mm256_and_si256(isValidYearAvx2(loadLanes(lanes.byr), 1920, 2002), isValidYearAvx2(loadLanes(lanes.iyr), 2010, 2020));
+        isValid = _mm256_and_si256(isValid, isValidYearAvx2(loadLanes(lanes.eyr), 2020, 2030));
+        isValid = _mm256_and_si256(isValid, isValidHeightAvx2(loadLanes(lanes.hgtDigits), loadLanes(lanes.hgtUnit), loadLanes(lanes.hgtCm)));
+        isValid = _mm256_and_si256(isValid, isValidHairColorAvx2(loadLanes(lanes.hclHead), loadLanes(lanes.hclTail)));
+        isValid = _mm256_and_si256(isValid, isValidEyeColorAvx2(loadLanes(lanes.ecl)));
+        const __m256i pidOk = _mm256_and_si256(areDigitsAvx2(loadLanes(lanes.pidHead)), _mm256_and_si256(areDigitsAvx2(loadLanes(lanes.pidMiddle)), areDigitsAvx2(loadLanes(lanes.pidTail))));
+        isValid = _mm256_and_si256(isValid, pidOk);
+        valid += Common::popcount(static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(isValid))));
+    }
+    for(; candidate < numCandidates; ++candidate)
+    {
+        valid += isValid(columns, candidates[candidate]);
+    }
+    return valid;
+}
+
+#endif
+
+}
+
+bool hasSimdPassportValidator()
+{
+    return Common::hasAvx2();
+}
+
+std::uint64_t countValidScalar(const PassportTable& passports)
+{
+    const Columns columns{passports};
+    return countCandidates(passports, [&columns](const std::uint32_t* candidates, std::size_t numCandidates)
+    {
+        std::uint64_t valid = 0;
+        for(std::size_t candidate = 0; candidate < numCandidates; ++candidate)
+        {
+            valid += isValid(columns, candidates[candidate]);
+        }
+        return valid;
+    });
+}
+
+std::uint64_t countValidSimd(const PassportTable& passports)
+{
+#ifdef AOC_X86
+    if(hasSimdPassportValidator())
+    {
+        const Columns columns{passports};
+        return countCandidates(passports, [&columns](const std::uint32_t* candidates, std::size_t numCandidates)
+        {
+            return countValidAvx2(columns, candidates, numCandidates);
+        });
+    }
+#endif
+    return countValidScalar(passports);
+}
+
+std::uint64_t countValid(const PassportTable& passports)
+{
+    return countValidSimd(passports);
+}
+
+PassportCounts& PassportCounts::operator+=(const PassportCounts& other)
+{
+    passports += other.passports;
+    complete += other.complete;
+    valid += other.valid;
+    return *this;
+}
+
+PassportCounts validatePassports(std::string_view input, Common::ThreadPool& pool)
+{
+    const std::vector<std::string_view> chunks = Common::splitRecordChunks(input, Common::getNumChunks(input.size(), pool.getNumThreads()));
+    std::vector<PassportCounts> chunkCounts(chunks.size());
+    pool.parallelFor(0, chunks.size(), 1, [&](std::size_t begin, std::size_t end)
+    {
+        for(std::size_t chunk = begin; chunk < end; ++chunk)
+        {
+            const PassportTable passports = PassportTable::parse(chunks[chunk]);
+            PassportCounts& counts = chunkCounts[chunk];
+            counts.passports = passports.size();
+            for(std::size_t passport = 0; passport < passports.size(); ++passport)
+            {
+                counts.complete += passports.hasAllRequiredFields(passport);
+            }
+            counts.valid = countValid(passports);
+        }
+    });
+
+    PassportCounts counts;
+    for(const PassportCounts& chunk : chunkCounts)
+    {
+        counts += chunk;
+    }
+    return counts;
+}
+
+}
@@ -0,0 +1,213 @@
+#include "Seats.hh"
+
+#include "Common/Cpu.hh"
+#include "Common/Parse.hh"
+
+#include <cstring>
+
+#include <algorithm>
+#include <string>
+
+namespace Day5
+{
+
+SeatId decodeSeat(const char* pass)
+{
+    std::uint64_t letters;
+    std::memcpy(&letters, pass, sizeof(letters));
+    const std::uint64_t ones = (~letters >> 2) & 0x0101010101010101;
+    // gathers the low bit of every byte into the top byte, first letter highest
+    const unsigned high = static_cast<unsigned>((ones * 0x8040201008040201) >> 56);
+    const unsigned low = ((~static_cast<unsigned>(pass[8]) >> 2) & 1) << 1 | ((~static_cast<unsigned>(pass[9]) >> 2) & 1);
+    return static_cast<SeatId>(high << 2 | low);
+}
+
+namespace
+{
+
+constexpr std::size_t NUM_ROW_LETTERS = 7;
+
+// The first 7 letters are F or B, which differ only in bit 2, and the last 3 are L or R; the
+// pass ends with the line or the input.
+bool isValidPass(const char* pass, const char* end)
+{
+    std::uint64_t letters;
+    std::memcpy(&letters, pass, sizeof(letters));
+    constexpr std::uint64_t ROW_BYTES = (std::uint64_t{1} << (8 * NUM_ROW_LETTERS)) - 1;
+    const bool rows = ((letters | 0x0404040404040404) & ROW_BYTES) == (0x4646464646464646 & ROW_BYTES);
+    bool columns = true;
+    for(std::size_t i = NUM_ROW_LETTERS; i < PASS_LENGTH; ++i)
+    {
+        columns &= (pass[i] == 'L') | (pass[i] == 'R');
+    }
+    const char* next = pass + PASS_LENGTH;
+    return rows & columns & (next == end || *next == '\n' || *next == '\r');
+}
+
+[[noreturn]] void failPass(const char* it, const char* end)
+{
+    const char* lineEnd = std::find(it, end, '\n');
+    if(lineEnd != it && lineEnd[-1] == '\r')
+        --lineEnd;
+    throw Common::ParseError{"not a boarding pass: \"" + std::string{it, lineEnd} + "\""};
+}
+
+const char* decodeScalar(const char* it, const char* end, SeatId*& out)
+{
+    for(;;)
+    {
+        while(it != end && (*it == '\n' || *it == '\r'))
+            ++it;
+        if(it == end)
+            break;
+        if(end - it < static_cast<std::ptrdiff_t>(PASS_LENGTH) || isValidPass(it, end) == false)
+            failPass(it, end);
+        *out++ = decodeSeat(it);
+        it += PASS_LENGTH;
+    }
+    return it;
+}
+
+#ifdef AOC_X86
+
+constexpr std::size_t LINES_PER_STEP = 16;
+
+// Two lines per 256-bit vector, one per 128-bit lane. A shuffle reverses the 10 letters so
+// the first one lands on the highest bit of the lane's movemask and puts the line end on
+// byte 15; bit 2 of each letter is shifted into the sign bit for the movemask. Every byte
+// is checked against the two it may be, the zero and the one letter of its position and
+// '\n' for the line end, so a malformed pass stops the step like a change of width.
+AOC_TARGET("avx2")
+const char* decodeAvx2(const char* it, const char* end, SeatId*& out)
+{
+    if(end - it < static_cast<std::ptrdiff_t>(PASS_LENGTH + 2))
+        return it;
+    const std::size_t stride = it[PASS_LENGTH] == '\n' ? PASS_LENGTH + 1
+        : it[PASS_LENGTH] == '\r' && it[PASS_LENGTH + 1] == '\n' ? PASS_LENGTH + 2 : 0;
+    if(stride == 0)
+        return it;
+
+    const char lineEnd = static_cast<char>(stride - 1);
+    const __m256i shuffle = _mm256_setr_epi8(
+        9, 8, 7, 6, 5, 4, 3, 2, 1, 0, -1, -1, -1, -1, -1, lineEnd,
+        9, 8, 7, 6, 5, 4, 3, 2, 1, 0, -1, -1, -1, -1, -1, lineEnd);
+    const __m256i zeros = _mm256_setr_epi8(
+        'L', 'L', 'L', 'F', 'F', 'F', 'F', 'F', 'F', 'F', 0, 0, 0, 0, 0, '\n',
+        'L', 'L', 'L', 'F', 'F', 'F', 'F', 'F', 'F', 'F', 0, 0, 0, 0, 0, '\n');
+    const __m256i ones = _mm256_setr_epi8(
+        'R', 'R', 'R', 'B', 'B', 'B', 'B', 'B', 'B', 'B', 0, 0, 0, 0, 0, '\n',
+        'R', 'R', 'R', 'B', 'B', 'B', 'B', 'B', 'B', 'B', 0, 0, 0, 0, 0, '\n');
+    // the last line of a step is loaded as 16 bytes from its start
+    const std::ptrdiff_t stepBytes = static_cast<std::ptrdiff_t>((LINES_PER_STEP - 1) * stride + 16);
+    while(end - it >= stepBytes)
+    {
+        std::array<unsigned, LINES_PER_STEP / 2> bits;
+        unsigned valid = ~0u;
+        for(std::size_t pair = 0; pair < bits.size(); ++pair)
+        {
+            const char* line = it + 2 * pair * stride;
+            const __m256i lines = _mm256_inserti128_si256(
+                _mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(line))),
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(line + stride)), 1);
+            const __m256i letters = _mm256_shuffle_epi8(lines, shuffle);
+            bits[pair] = ~static_cast<unsigned>(_mm256_movemask_epi8(_mm256_slli_epi16(letters, 5)));
+            valid &= static_cast<unsigned>(_mm256_movemask_epi8(_mm256_or_si256(_mm256_cmpeq_epi8(letters, zeros), _mm256_cmpeq_epi8(letters, ones))));
+        }
+        if(valid != ~0u)
+            break;      // the lines change width or a pass is malformed somewhere in this step: the scalar decoder takes over
+        for(std::size_t pair = 0; pair < bits.size(); ++pair)
+        {
+            out[2 * pair] = static_cast<SeatId>(bits[pair] & (NUM_SEATS - 1));
+            out[2 * pair + 1] = static_cast<SeatId>((bits[pair] >> 16) & (NUM_SEATS - 1));
+        }
+        out += LINES_PER_STEP;
+        it += LINES_PER_STEP * stride;
+    }
+    return it;
+}
+
+#endif
+
+// SeatMap::decode cuts the manifest after the first newline past DECODE_BLOCK_BYTES, and
+// at MAX_BLOCK_BYTES at the latest, so a block never holds more than MAX_BLOCK_SEATS passes.
+constexpr std::size_t DECODE_BLOCK_BYTES = 32 * 1024;
+constexpr std::size_t MAX_BLOCK_BYTES = DECODE_BLOCK_BYTES + PASS_LENGTH + 2;
+constexpr std::size_t MAX_BLOCK_SEATS = MAX_BLOCK_BYTES / PASS_LENGTH + 1;
+
+}
+
+bool hasSimdSeatDecoder()
+{
+    return Common::hasAvx2();
+}
+
+std::size_t decodeSeatsScalar(std::string_view input, SeatId* out)
+{
+    SeatId* begin = out;
+    decodeScalar(input.data(), input.data() + input.size(), out);
+    return static_cast<std::size_t>(out - begin);
+}
+
+std::size_t decodeSeatsSimd(std::string_view input, SeatId* out)
+{
+    SeatId* begin = out;
+    const char* it = input.data();
+    const char* end = it + input.size();
+#ifdef AOC_X86
+    if(hasSimdSeatDecoder())
+    {
+        it = decodeAvx2(it, end, out);
+    }
+#endif
+    decodeScalar(it, end, out);
+    return static_cast<std::size_t>(out - begin);
+}
+
+SeatMap SeatMap::decode(std::string_view input)
+{
+    // decoded a block of lines at a time into a small buffer, never the whole manifest
+    SeatMap map;
+    std::array<SeatId, MAX_BLOCK_SEATS> seats;
+    while(input.empty() == false)
+    {
+        std::size_t cut = input.find('\n', std::min(input.size(), DECODE_BLOCK_BYTES) - 1);
+        cut = std::min(cut == std::string_view::npos ? input.size() : cut + 1, MAX_BLOCK_BYTES);
+        const std::size_t count = decodeSeatsSimd(input.substr(0, cut), seats.data());
+        for(std::size_t i = 0; i < count; ++i)
+        {
+            map.add(seats[i]);
+        }
+        input.remove_prefix(cut);
+    }
+    return map;
+}
+
+std::optional<SeatId> SeatMap::getHighest() const
+{
+    for(std::size_t word = words.size(); word-- > 0;)
+    {
+        if(words[word] != 0)
+        {
+            return static_cast<SeatId>(word * 64 + Common::getHighestBit(words[word]));
+        }
+    }
+    return std::nullopt;
+}
+
+SeatIds SeatMap::findFreeBetweenOccupied() const
+{
+    SeatIds seats;
+    for(std::size_t word = 0; word < words.size(); ++word)
+    {
+        // bit i of below is the seat before seat i, bit i of above the seat after it
+        const std::uint64_t below = words[word] << 1 | (word > 0 ? words[word - 1] >> 63 : 0);
+        const std::uint64_t above = words[word] >> 1 | (word + 1 < words.size() ? words[word + 1] << 63 : 0);
+        for(std::uint64_t free = ~words[word] & below & above; free != 0; free &= free - 1)
+        {
+            seats.push_back(static_cast<SeatId>(word * 64 + Common::countTrailingZeros(free)));
+        }
+    }
+    return seats;
+}
+
+}
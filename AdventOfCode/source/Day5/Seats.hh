@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <array>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace Day5
+{
+
+// row * 8 + column, which is just the 10 letters of a pass read as binary
+using SeatId = std::uint16_t;
+using SeatIds = std::vector<SeatId>;
+
+constexpr std::size_t PASS_LENGTH = 10;
+constexpr std::size_t NUM_SEATS = 1 << PASS_LENGTH;
+
+// B and R are the ones, F and L the zeros: bit 2 of the letter is clear exactly for the ones.
+// The first 8 letters are decoded together with one multiply; no branches either way.
+SeatId decodeSeat(const char* pass);
+
+// Bulk decoders for a manifest of one pass per line. They write to out, which must have room
+// for getMaxSeatCount(input) ids, and return the number of passes decoded. The SIMD one reads
+// 16 lines per iteration with AVX2 while the lines keep the width of the first one, and hands
+// whatever is left to the scalar one; it is all scalar when the CPU has no AVX2. Both throw
+// Common::ParseError on a line that is not 7 of F or B followed by 3 of L or R.
+constexpr std::size_t getMaxSeatCount(std::string_view input) { return input.size() / PASS_LENGTH + 1; }
+std::size_t decodeSeatsScalar(std::string_view input, SeatId* out);
+std::size_t decodeSeatsSimd(std::string_view input, SeatId* out);
+bool hasSimdSeatDecoder();
+
+// Which seats of the plane are taken, one bit per seat id. The queries scan the 16 words of
+// the bitmap, so they cost the same however many passes the manifest has.
+struct SeatMap
+{
+public:
+    // Decodes the manifest straight into the bitmap, without keeping the seat ids.
+    static SeatMap decode(std::string_view input);
+
+    void add(SeatId seat) { words[seat / 64] |= std::uint64_t{1} << (seat % 64); ++numPasses; }
+    bool isOccupied(SeatId seat) const { return (words[seat / 64] >> (seat % 64)) & 1; }
+    std::size_t getNumPasses() const { return numPasses; }
+
+    std::optional<SeatId> getHighest() const;
+    // The free seats whose neighbours on both sides are occupied, ascending.
+    SeatIds findFreeBetweenOccupied() const;
+
+private:
+    std::array<std::uint64_t, NUM_SEATS / 64> words{};
+    std::size_t numPasses = 0;
+};
+
+}
@@ -0,0 +1,98 @@
+#include "Answers.hh"
+
+#include "Common/Cpu.hh"
+#include "Common/Input.hh"
+#include "Common/ThreadPool.hh"
+
+#include <vector>
+
+namespace Day6
+{
+
+AnswerCounts& AnswerCounts::operator+=(const AnswerCounts& other)
+{
+    groups += other.groups;
+    anyone += other.anyone;
+    everyone += other.everyone;
+    return *this;
+}
+
+AnswerCounts countAnswers(std::string_view input)
+{
+    AnswerCounts counts;
+    AnswerMask anyone = 0;
+    AnswerMask everyone = ~AnswerMask{0};
+    bool inGroup = false;
+    auto endGroup = [&]()
+    {
+        if(inGroup)
+        {
+            ++counts.groups;
+            counts.anyone += Common::popcount(anyone);
+            counts.everyone += Common::popcount(everyone);
+        }
+        anyone = 0;
+        everyone = ~AnswerMask{0};
+        inGroup = false;
+    };
+
+    AnswerMask person = 0;
+    bool inLine = false;
+    for(char c : input)
+    {
+        if(c == '\n')
+        {
+            if(inLine)
+            {
+                anyone |= person;
+                everyone &= person;
+                inGroup = true;
+            }
+            else
+            {
+                endGroup();
+            }
+            person = 0;
+            inLine = false;
+        }
+        else
+        {
+            const unsigned question = static_cast<unsigned char>(c - 'a');
+            if(question < NUM_QUESTIONS)
+            {
+                person |= AnswerMask{1} << question;
+                inLine = true;
+            }
+        }
+    }
+    if(inLine)
+    {
+        anyone |= person;
+        everyone &= person;
+        inGroup = true;
+    }
+    endGroup();
+    return counts;
+}
+
+AnswerCounts countAnswers(std::string_view input, Common::ThreadPool& pool)
+{
+    const std::vector<std::string_view> chunks = Common::splitRecordChunks(input, Common::getNumChunks(input.size(), pool.getNumThreads()));
+    std::vector<AnswerCounts> chunkCounts(chunks.size());
+    pool.parallelFor(0, chunks.size(), 1, [&](std::size_t begin, std::size_t end)
+    {
+        for(std::size_t chunk = begin; chunk < end; ++chunk)
+        {
+            chunkCounts[chunk] = countAnswers(chunks[chunk]);
+        }
+    });
+
+    AnswerCounts counts;
+    for(const AnswerCounts& chunk : chunkCounts)
+    {
+        counts += chunk;
+    }
+    return counts;
+}
+
+}
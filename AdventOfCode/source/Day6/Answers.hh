@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstdint>
+
+#include <string_view>
+
+namespace Common
+{
+struct ThreadPool;
+}
+
+namespace Day6
+{
+
+// The questions a person answered yes to, bit 0 for 'a' up to bit 25 for 'z'.
+using AnswerMask = std::uint32_t;
+constexpr unsigned NUM_QUESTIONS = 26;
+
+struct AnswerCounts
+{
+    std::uint64_t groups = 0;
+    std::uint64_t anyone = 0;
+    std::uint64_t everyone = 0;
+
+    AnswerCounts& operator+=(const AnswerCounts& other);
+};
+
+// Sums over the groups of the questions anyone in the group answered and everyone answered,
+// in a single scan that folds every person into the union and the intersection of the
+// current group's masks as it goes, so nothing but the counts is stored. Bytes other than
+// 'a' to 'z', such as the \r of CRLF files, are skipped; a line without any is blank.
+AnswerCounts countAnswers(std::string_view input);
+// Same, on chunks cut at blank lines so no group straddles two of them, spread over the pool.
+AnswerCounts countAnswers(std::string_view input, Common::ThreadPool& pool);
+
+}
@@ -1,15 +1,19 @@
+#include "Common/Benchmark.hh"
+#include "Common/Input.hh"
+#include "Common/Parse.hh"
+#include "Common/Registry.hh"
+
 #include <cassert>
 
 #include <algorithm>
 #include <filesystem>
 #include <functional>
-#include <fstream>
 #include <iostream>
 #include <map>
 #include <numeric>
 #include <set>
 #include <string>
-#include <sstream>
+#include <string_view>
 #include <vector>
 
 namespace Day7
@@ -31,44 +35,34 @@ using Bags = std::map<std::string, Bag>;
 // parse bag line
 // minden baghez: lista a parentekről, amiben benne lehet
 
-void parseBag(const std::string& line, Bags& bags)
+void parseBag(std::string_view line, Bags& bags)
 {
-    static const std::string MAGIC{"bags contain "};
+    static constexpr std::string_view MAGIC{"bags contain "};
     auto bagsPos = line.find(MAGIC);
-    assert(bagsPos != std::string::npos);
+    assert(bagsPos != std::string_view::npos);
 
     Bag bag;
 
-    std::string color = line.substr(0, bagsPos - 1);
-    std::stringstream parentsStream{line.substr(bagsPos + MAGIC.size() - 1)};
-    auto foo = parentsStream.str();
-    for(std::string part; std::getline(parentsStream, part, ',');)
+    std::string color{line.substr(0, bagsPos - 1)};
+    // "1 bright white bag, 2 muted yellow bags." or "no other bags."
+    std::string_view rest = line.substr(bagsPos + MAGIC.size());
+    for(Content content; Common::parseNumber(rest, content.num);)
     {
-        if (part == " no other bags.")
-        {
-            break;
-        }
-        if (part[part.size() - 1] == '.')
-        {
-            part.erase(part.end() - 1);
-        }
-        std::stringstream ss{ part };
-        Content content;
-        ss >> content.num;
-        ss >> std::ws;
-        std::getline(ss, content.color);
-        static const std::string BAG_MAGIC{" bag"};
-        content.color = content.color.substr(0, content.color.find(BAG_MAGIC));
+        auto bagPos = rest.find(" bag");
+        assert(bagPos != std::string_view::npos);
+        content.color = rest.substr(1, bagPos - 1);
+        auto nextPos = rest.find(", ", bagPos);
+        rest.remove_prefix(nextPos == std::string_view::npos ? rest.size() : nextPos + 2);
         bag.contents.push_back(content);
         bags[content.color].parents.insert(color);
     }
     bags[color].contents = bag.contents; // contents are loaded once, parents are loaded throughout the parse
 }
 
-Bags parseBags(std::ifstream& file)
+Bags parseBags(std::string_view input)
 {
     Bags result;
-    for(std::string line; std::getline(file, line);)
+    for(std::string_view line : Common::Lines{input})
     {
         parseBag(line, result);
     }
@@ -95,16 +89,23 @@ int countRecursiveParents(const std::string& color, const Bags& bags)
     return parents.size();
 }
 
+static const std::string COLOR = "shiny gold";
+
+std::uint64_t getAnswerPart1(const std::filesystem::path& path)
+{
+    Common::MappedFile file{path};
+    assert(file.isOpen());
+    Bags bags = parseBags(file.getContent());
+    Common::markParsed(bags.size());
+    return countRecursiveParents(COLOR, bags);
+}
+
 void part1()
 {
     std::filesystem::path path{ std::filesystem::current_path().parent_path() };
     path += "/data/PuzzleInput/Day7/input.txt";
     //path += "/data/PuzzleInput/Day7/test";
-    std::ifstream file{path};
-    Bags bags = parseBags(file);
-
-    static const std::string COLOR = "shiny gold";
-    auto sum = countRecursiveParents(COLOR, bags);
+    auto sum = getAnswerPart1(path);
     std::cout << "part1: " << sum << "\n"; // 300
 
     int debug = 1323;
@@ -130,18 +131,32 @@ int calculateNumBags(const std::string& color, const Bags& bags)
     return calculateNumBags_internal(color, bags) - 1;
 }
 
+std::uint64_t getAnswerPart2(const std::filesystem::path& path)
+{
+    Common::MappedFile file{path};
+    assert(file.isOpen());
+    Bags bags = parseBags(file.getContent());
+    Common::markParsed(bags.size());
+    return calculateNumBags(COLOR, bags);
+}
+
 void part2()
 {
     std::filesystem::path path{ std::filesystem::current_path().parent_path() };
     path += "/data/PuzzleInput/Day7/input.txt";
     //path += "/data/PuzzleInput/Day7/test";
     //path += "/data/PuzzleInput/Day7/test2";
-    std::ifstream file{ path };
-    Bags bags = parseBags(file);
-    static const std::string COLOR = "shiny gold";
-    auto num = calculateNumBags(COLOR, bags);
+    auto num = getAnswerPart2(path);
     std::cout << "part2: " << num << "\n";
     int debug = 123;
 }
 
-}
\ No newline at end of file
+static const Common::Registration registration{
+    { 7, 1, "Day7/input.txt", getAnswerPart1 },
+    { 7, 1, "Day7/test", getAnswerPart1 },
+    { 7, 2, "Day7/input.txt", getAnswerPart2 },
+    { 7, 2, "Day7/test", getAnswerPart2 },
+    { 7, 2, "Day7/test2", getAnswerPart2 },
+};
+
+}
@@ -1,3 +1,8 @@
+#include "Common/Benchmark.hh"
+#include "Common/Input.hh"
+#include "Common/Parse.hh"
+#include "Common/Registry.hh"
+
 #include <cassert>
 
 #include <algorithm>
@@ -9,6 +14,7 @@
 #include <numeric>
 #include <set>
 #include <string>
+#include <string_view>
 #include <sstream>
 #include <vector>
 
@@ -23,16 +29,15 @@ struct Instruction
 
 using Instructions = std::vector<Instruction>;
 
-Instructions load(std::istream& stream)
+Instructions load(std::string_view input)
 {
     Instructions result;
-    for (std::string line; std::getline(stream, line);)
+    for (std::string_view line : Common::Lines{input})
     {
         Instruction instruction;
         constexpr int MAGIC = 3;
         instruction.code = line.substr(0, MAGIC);
-        std::stringstream ss(line.substr(MAGIC));
-        ss >> instruction.parameter;
+        instruction.parameter = Common::toNumber<int>(line.substr(MAGIC + 1));
         result.push_back(instruction);
     }
     return result;
@@ -71,15 +76,23 @@ std::pair<std::int64_t, bool> accBeforeLoop(const Instructions& instructions)
     return {acc, infinite};
 }
 
+std::int64_t getAnswerPart1(const std::filesystem::path& path)
+{
+    Common::MappedFile file{ path };
+    assert(file.isOpen());
+    Instructions instructions = load(file.getContent());
+    Common::markParsed(instructions.size());
+    auto [answer, infinite]= accBeforeLoop(instructions);
+    assert(infinite);
+    return answer;
+}
+
 void part1()
 {
     std::filesystem::path path{ std::filesystem::current_path().parent_path() };
     path += "/data/PuzzleInput/Day8/input.txt";
     //path += "/data/PuzzleInput/Day8/test";
-    std::ifstream file{ path };
-    Instructions instructions = load(file);
-    auto [answer, infinite]= accBeforeLoop(instructions);
-    assert(infinite);
+    auto answer = getAnswerPart1(path);
     std::cout << "part1: " << answer << "\n"; // 1553
     int debug = 123;
 }
@@ -102,19 +115,17 @@ void flip(Instructions& instructions, const std::size_t i)
     }
 }
 
-void part2()
+std::int64_t getAnswerPart2(const std::filesystem::path& path)
 {
-    std::filesystem::path path{ std::filesystem::current_path().parent_path() };
-    path += "/data/PuzzleInput/Day8/input.txt";
-    //path += "/data/PuzzleInput/Day8/test";
-    std::ifstream file{ path };
-    Instructions instructions = load(file);
+    Common::MappedFile file{ path };
+    assert(file.isOpen());
+    Instructions instructions = load(file.getContent());
+    Common::markParsed(instructions.size());
 
     auto [answer, infinite] = accBeforeLoop(instructions);
     if (infinite == false)
     {
-        std::cout << "part2: " << answer << "\n"; // 1877
-        return;
+        return answer;
     }
     for (std::size_t i = 0; i < instructions.size(); ++i)
     {
@@ -124,13 +135,28 @@ void part2()
             auto [answer, infinite] = accBeforeLoop(instructions);
             if (infinite == false)
             {
-                std::cout << "part2: " << answer << "\n";
-                return;
+                return answer;
             }
             flip(instructions, i);
         }
     }
-    int debug = 123;
+    assert(false);
+    return 0;
 }
 
-}
\ No newline at end of file
+void part2()
+{
+    std::filesystem::path path{ std::filesystem::current_path().parent_path() };
+    path += "/data/PuzzleInput/Day8/input.txt";
+    //path += "/data/PuzzleInput/Day8/test";
+    std::cout << "part2: " << getAnswerPart2(path) << "\n"; // 1877
+}
+
+static const Common::Registration registration{
+    { 8, 1, "Day8/input.txt", getAnswerPart1 },
+    { 8, 1, "Day8/test", getAnswerPart1 },
+    { 8, 2, "Day8/input.txt", getAnswerPart2 },
+    { 8, 2, "Day8/test", getAnswerPart2 },
+};
+
+}
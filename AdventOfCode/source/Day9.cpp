@@ -1,3 +1,9 @@
+#include "Common/Benchmark.hh"
+#include "Common/Input.hh"
+#include "Common/Parse.hh"
+#include "Common/Registry.hh"
+#include "Common/Trace.hh"
+
 #include <cassert>
 
 #include <algorithm>
@@ -9,6 +15,7 @@
 #include <numeric>
 #include <set>
 #include <string>
+#include <string_view>
 #include <sstream>
 #include <vector>
 
@@ -18,20 +25,9 @@ namespace Day9
     using Number = std::uint64_t;
     using Numbers = std::vector<Number>;
 
-    Numbers loadNumbers(std::istream& stream)
+    Numbers loadNumbers(std::string_view input)
     {
-        Numbers result;
-        assert(stream);
-        for (; stream;)
-        {
-            std::uint64_t temp = 0;
-            stream >> temp;
-            if (stream)
-            {
-                result.push_back(temp);
-            }
-        }
-        return result;
+        return Common::parseNumbers<Number>(input);
     }
 
     std::set<Number> calculateValidValues(const Numbers& numbers, std::size_t beginIndex, std::size_t endIndex)
@@ -53,6 +49,7 @@ namespace Day9
 
     std::tuple<bool, std::size_t, std::size_t> getContiguousRange(const Numbers& numbers, Number sum)
     {
+        AOC_TRACE_SCOPE("getContiguousRange");
         for (std::size_t i = 0; i < numbers.size(); ++i)
         {
             Number tempSum = 0;
@@ -102,6 +99,7 @@ namespace Day9
 
     std::pair<bool, Number> getFirstInvalid(const Numbers& numbers, std::size_t preambleSize)
     {
+        AOC_TRACE_SCOPE("getFirstInvalid");
         for (std::size_t i = preambleSize; i < numbers.size(); ++i)
         {
             if (isValid(numbers, i, preambleSize) == false)
@@ -112,31 +110,55 @@ namespace Day9
         return { false, 0 };
     }
 
+    Number getAnswerPart1(const std::filesystem::path& path, std::size_t preambleSize)
+    {
+        Common::MappedFile file{ path };
+        assert(file.isOpen());
+        auto numbers = loadNumbers(file.getContent());
+        Common::markParsed(numbers.size());
+        auto [foundFirstInvalid, firstInvalid] = getFirstInvalid(numbers, preambleSize);
+        assert(foundFirstInvalid);
+        return firstInvalid;
+    }
+
+    Number getAnswerPart2(const std::filesystem::path& path, std::size_t preambleSize)
+    {
+        Common::MappedFile file{ path };
+        assert(file.isOpen());
+        auto numbers = loadNumbers(file.getContent());
+        Common::markParsed(numbers.size());
+        auto [foundFirstInvalid, firstInvalid] = getFirstInvalid(numbers, preambleSize);
+        assert(foundFirstInvalid);
+        auto [foundRange, i, j] = getContiguousRange(numbers, firstInvalid);
+        assert(foundRange);
+        return sumSmallestAndLargest(numbers, i, j);
+    }
+
     void part1()
     {
         std::filesystem::path path{ std::filesystem::current_path().parent_path() };
         path += "/data/PuzzleInput/Day9/input.txt";
         //path += "/data/PuzzleInput/Day9/test";
-        std::ifstream file{ path };
-        assert(file);
 
         //auto PREAMBLE_SIZE = 5; // test
         auto PREAMBLE_SIZE = 25;
 
-        auto numbers = loadNumbers(file);
-        auto [foundFirstInvalid, firstInvalid] = getFirstInvalid(numbers, PREAMBLE_SIZE);
-        assert(foundFirstInvalid);
-        //assert(firstInvalid == 675280050);
+        auto firstInvalid = getAnswerPart1(path, PREAMBLE_SIZE);
         std::cout << "part1: " << firstInvalid << "\n";
         // part1: 675280050
 
-        auto[foundRange, i, j] = getContiguousRange(numbers, firstInvalid);
-        assert(foundRange);
-        Number part2Result = sumSmallestAndLargest(numbers, i, j);
-        //Number result = numbers[i] + numbers[j];
+        Number part2Result = getAnswerPart2(path, PREAMBLE_SIZE);
         std::cout << "part2: " << part2Result << "\n"; // 96081673
-
-        int debug = 123;
     }
 
-}
\ No newline at end of file
+    static constexpr std::size_t PREAMBLE_SIZE = 25;
+    static constexpr std::size_t PREAMBLE_SIZE_TEST = 5;
+
+    static const Common::Registration registration{
+        { 9, 1, "Day9/input.txt", [](const auto& path) { return getAnswerPart1(path, PREAMBLE_SIZE); } },
+        { 9, 1, "Day9/test", [](const auto& path) { return getAnswerPart1(path, PREAMBLE_SIZE_TEST); } },
+        { 9, 2, "Day9/input.txt", [](const auto& path) { return getAnswerPart2(path, PREAMBLE_SIZE); } },
+        { 9, 2, "Day9/test", [](const auto& path) { return getAnswerPart2(path, PREAMBLE_SIZE_TEST); } },
+    };
+
+}
@@ -0,0 +1,92 @@
+#include "Generator/Generator.hh"
+
+#include <cstdlib>
+
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+void printUsage(std::ostream& stream)
+{
+    stream <<
+        "usage: aoc_generate [-o <file>] <day> <size> [<seed>]\n"
+        "       aoc_generate --list\n"
+        "  writes a synthetic puzzle input for <day> to stdout, or to <file>\n";
+}
+
+}
+
+int main(int argc, char* argv[])
+{
+    std::string outputPath;
+    std::vector<std::string> positional;
+    for(int i = 1; i < argc; ++i)
+    {
+        const std::string arg{argv[i]};
+        if(arg == "--list")
+        {
+            for(const Generator::DayGenerator& generator : Generator::getGenerators())
+            {
+                std::cout << "day " << generator.day << ": size = " << generator.sizeDescription << "\n";
+            }
+            return EXIT_SUCCESS;
+        }
+        else if(arg == "-o" && i + 1 < argc)
+        {
+            outputPath = argv[++i];
+        }
+        else if(arg == "--help" || arg == "-h")
+        {
+            printUsage(std::cout);
+            return EXIT_SUCCESS;
+        }
+        else
+        {
+            positional.push_back(arg);
+        }
+    }
+    if(positional.size() < 2 || positional.size() > 3)
+    {
+        printUsage(std::cerr);
+        return EXIT_FAILURE;
+    }
+
+    int day = 0;
+    std::size_t size = 0;
+    std::uint64_t seed = 0;
+    try
+    {
+        day = std::stoi(positional[0]);
+        size = std::stoull(positional[1]);
+        seed = positional.size() > 2 ? std::stoull(positional[2]) : 0;
+    }
+    catch(...)
+    {
+        printUsage(std::cerr);
+        return EXIT_FAILURE;
+    }
+    if(Generator::findGenerator(day) == nullptr)
+    {
+        std::cerr << "no generator for day " << day << "\n";
+        return EXIT_FAILURE;
+    }
+
+    const std::string input = Generator::generate(day, size, seed);
+    if(outputPath.empty())
+    {
+        std::cout << input;
+        return std::cout ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+    std::ofstream file{outputPath, std::ios::binary};
+    file << input;
+    if(!file)
+    {
+        std::cerr << "cannot write " << outputPath << "\n";
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
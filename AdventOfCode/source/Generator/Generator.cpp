@@ -0,0 +1,699 @@
+#include "Generator.hh"
+
+#include <cassert>
+
+#include <algorithm>
+#include <array>
+#include <deque>
+#include <iterator>
+#include <numeric>
+#include <random>
+#include <set>
+#include <string_view>
+
+namespace Generator
+{
+
+namespace
+{
+
+// std::uniform_int_distribution differs between standard libraries, the raw engine does not.
+struct Random
+{
+    explicit Random(std::uint64_t seed) : engine{seed} {}
+
+    std::uint64_t operator()(std::uint64_t min, std::uint64_t max) { return min + engine() % (max - min + 1); }
+    bool chance(unsigned percent) { return (*this)(0, 99) < percent; }
+
+    template<typename T>
+    void shuffle(std::vector<T>& values)
+    {
+        for(std::size_t i = values.size(); i > 1; --i)
+        {
+            std::swap(values[i - 1], values[(*this)(0, i - 1)]);
+        }
+    }
+
+    template<typename T, std::size_t N>
+    const T& pick(const std::array<T, N>& values) { return values[(*this)(0, N - 1)]; }
+
+    std::mt19937_64 engine;
+};
+
+void appendLine(std::string& output, std::uint64_t value)
+{
+    output += std::to_string(value);
+    output += '\n';
+}
+
+std::string generateDay1(std::size_t size, std::uint64_t seed)
+{
+    // Exactly one pair and one triple sum to 2020; the filler is above 2020 and never matches.
+    constexpr std::uint64_t MAGIC = 2020;
+    Random random{seed};
+
+    auto countSums = [](const std::vector<std::uint64_t>& values, std::size_t k)
+    {
+        // at distinct positions, as the solvers use every entry at most once
+        std::size_t count = 0;
+        for(std::size_t i = 0; i < values.size(); ++i)
+            for(std::size_t j = i + 1; j < values.size(); ++j)
+            {
+                if(k == 2)
+                    count += values[i] + values[j] == MAGIC;
+                else
+                    for(std::size_t l = j + 1; l < values.size(); ++l)
+                        count += values[i] + values[j] + values[l] == MAGIC;
+            }
+        return count;
+    };
+
+    std::vector<std::uint64_t> planted;
+    do
+    {
+        std::uint64_t a = random(1, MAGIC - 1);
+        std::uint64_t c = random(1, MAGIC / 3);
+        std::uint64_t d = random(1, MAGIC / 3);
+        planted = {a, MAGIC - a, c, d, MAGIC - c - d};
+    }
+    while(std::set<std::uint64_t>(planted.begin(), planted.end()).size() != planted.size() ||
+          countSums(planted, 2) != 1 || countSums(planted, 3) != 1);
+
+    std::vector<std::uint64_t> values;
+    values.reserve(std::max(size, planted.size()));
+    values.insert(values.end(), planted.begin(), planted.end());
+    while(values.size() < size)
+    {
+        values.push_back(random(MAGIC + 1, 999999));
+    }
+    random.shuffle(values);
+
+    std::string output;
+    for(std::uint64_t value : values)
+    {
+        appendLine(output, value);
+    }
+    return output;
+}
+
+std::string generateDay2(std::size_t size, std::uint64_t seed)
+{
+    Random random{seed};
+    std::string output;
+    for(std::size_t i = 0; i < size; ++i)
+    {
+        const std::uint64_t min = random(1, 10);
+        const std::uint64_t max = random(min + 1, min + 10);
+        const char letter = static_cast<char>('a' + random(0, 25));
+        const std::uint64_t length = random(max, max + 10);
+        output += std::to_string(min) + '-' + std::to_string(max) + ' ' + letter + ": ";
+        for(std::uint64_t j = 0; j < length; ++j)
+        {
+            output += random.chance(30) ? letter : static_cast<char>('a' + random(0, 25));
+        }
+        output += '\n';
+    }
+    return output;
+}
+
+std::string generateGrid(std::size_t rows, std::size_t columns, char set, char unset, unsigned percent, std::uint64_t seed)
+{
+    Random random{seed};
+    std::string output;
+    output.reserve(rows * (columns + 1));
+    for(std::size_t row = 0; row < rows; ++row)
+    {
+        for(std::size_t column = 0; column < columns; ++column)
+        {
+            output += random.chance(percent) ? set : unset;
+        }
+        output += '\n';
+    }
+    return output;
+}
+
+std::string generateDay3(std::size_t size, std::uint64_t seed)
+{
+    return generateTreeMap(size, 31, seed);
+}
+
+std::string generateDay4(std::size_t size, std::uint64_t seed)
+{
+    static const std::array<const char*, 7> EYE_COLORS = {"amb", "blu", "brn", "gry", "grn", "hzl", "oth"};
+    static const std::array<const char*, 3> BAD_EYE_COLORS = {"xyz", "gmt", "zzz"};
+    static const char* HEX = "0123456789abcdef";
+    Random random{seed};
+
+    auto digits = [&random](std::size_t count)
+    {
+        std::string result;
+        for(std::size_t i = 0; i < count; ++i)
+            result += static_cast<char>('0' + random(0, 9));
+        return result;
+    };
+    auto year = [&random](std::uint64_t min, std::uint64_t max, bool valid)
+    {
+        return std::to_string(valid ? random(min, max) : (random.chance(50) ? random(min - 30, min - 1) : random(max + 1, max + 30)));
+    };
+
+    std::string output;
+    for(std::size_t i = 0; i < size; ++i)
+    {
+        std::vector<std::string> fields;
+        auto add = [&](const char* name, std::string value, bool required)
+        {
+            if(required == false || random.chance(92))
+                fields.push_back(std::string{name} + ':' + value);
+        };
+        auto valid = [&random]() { return random.chance(85); };
+
+        add("byr", year(1920, 2002, valid()), true);
+        add("iyr", year(2010, 2020, valid()), true);
+        add("eyr", year(2020, 2030, valid()), true);
+        if(valid())
+            add("hgt", random.chance(50) ? std::to_string(random(150, 193)) + "cm" : std::to_string(random(59, 76)) + "in", true);
+        else
+            add("hgt", random.chance(50) ? std::to_string(random(59, 76)) + "cm" : std::to_string(random(150, 193)), true);
+        std::string hairColor = "#";
+        for(int j = 0; j < 6; ++j)
+            hairColor += HEX[random(0, 15)];
+        if(valid() == false)
+            hairColor[random.chance(50) ? 0 : 3] = 'z';
+        add("hcl", hairColor, true);
+        add("ecl", valid() ? random.pick(EYE_COLORS) : random.pick(BAD_EYE_COLORS), true);
+        add("pid", digits(valid() ? 9 : random(8, 10)), true);
+        if(random.chance(50))
+            add("cid", std::to_string(random(100, 350)), false);
+
+        random.shuffle(fields);
+        for(std::size_t j = 0; j < fields.size(); ++j)
+        {
+            output += fields[j];
+            output += j + 1 == fields.size() || random.chance(30) ? '\n' : ' ';
+        }
+        output += '\n';
+    }
+    return output;
+}
+
+std::string generateDay5(std::size_t size, std::uint64_t seed)
+{
+    // One seat between two occupied ones stays free. Manifests larger than the plane
+    // repeat the occupied seats.
+    constexpr std::uint64_t SEATS = 1024;
+    Random random{seed};
+    const std::uint64_t occupied = std::clamp<std::uint64_t>(size, 2, SEATS - 1);
+    const std::uint64_t first = random(0, SEATS - 1 - occupied);
+    const std::uint64_t free = random(first + 1, first + occupied - 1);
+
+    std::vector<std::uint64_t> seats;
+    seats.reserve(std::max<std::size_t>(size, occupied));
+    for(std::uint64_t seat = first; seat <= first + occupied; ++seat)
+    {
+        if(seat != free)
+            seats.push_back(seat);
+    }
+    while(seats.size() < size)
+    {
+        seats.push_back(seats[random(0, occupied - 1)]);
+    }
+    random.shuffle(seats);
+
+    std::string output;
+    output.reserve(seats.size() * 11);
+    for(std::uint64_t seat : seats)
+    {
+        for(int bit = 9; bit >= 3; --bit)
+            output += (seat >> bit) & 1 ? 'B' : 'F';
+        for(int bit = 2; bit >= 0; --bit)
+            output += (seat >> bit) & 1 ? 'R' : 'L';
+        output += '\n';
+    }
+    return output;
+}
+
+std::string generateDay6(std::size_t size, std::uint64_t seed)
+{
+    Random random{seed};
+    std::string output;
+    for(std::size_t i = 0; i < size; ++i)
+    {
+        const std::uint64_t common = random(0, (1u << 26) - 1) & random(0, (1u << 26) - 1);
+        const std::uint64_t people = random(1, 5);
+        for(std::uint64_t person = 0; person < people; ++person)
+        {
+            std::uint64_t answers = common | (random(0, (1u << 26) - 1) & random(0, (1u << 26) - 1));
+            if(answers == 0)
+                answers = 1u << random(0, 25);
+            for(int letter = 0; letter < 26; ++letter)
+            {
+                if((answers >> letter) & 1)
+                    output += static_cast<char>('a' + letter);
+            }
+            output += '\n';
+        }
+        if(i + 1 < size)
+            output += '\n';
+    }
+    return output;
+}
+
+std::string generateDay7(std::size_t size, std::uint64_t seed)
+{
+    // Rules form independent clusters of forward edges, so the solvers' unmemoised
+    // recursion stays bounded however many rules there are.
+    static const std::array<const char*, 16> ADJECTIVES = {"light", "dark", "bright", "muted", "faded", "dotted", "vibrant", "posh",
+                                                         "clear", "drab", "dull", "mirrored", "pale", "plaid", "striped", "wavy"};
+    static const std::array<const char*, 16> COLORS = {"red", "orange", "white", "yellow", "olive", "plum", "blue", "black",
+                                                     "teal", "tan", "cyan", "lime", "maroon", "coral", "beige", "silver"};
+    constexpr std::size_t CLUSTER = 24;
+    Random random{seed};
+
+    auto name = [](std::size_t index)
+    {
+        const std::size_t combinations = ADJECTIVES.size() * COLORS.size();
+        std::string result = ADJECTIVES[index % ADJECTIVES.size()];
+        if(index >= combinations)
+            result += std::to_string(index / combinations);
+        return result + ' ' + COLORS[(index / ADJECTIVES.size()) % COLORS.size()];
+    };
+
+    size = std::max<std::size_t>(size, 2);
+    const std::size_t gold = size / 2;
+    std::vector<std::string> names(size);
+    for(std::size_t i = 0; i < size; ++i)
+        names[i] = i == gold ? "shiny gold" : name(i < gold ? i : i - 1);
+
+    std::vector<std::string> rules;
+    for(std::size_t i = 0; i < size; ++i)
+    {
+        const std::size_t clusterEnd = std::min(size, (i / CLUSTER + 1) * CLUSTER);
+        std::string rule = names[i] + " bags contain ";
+        std::set<std::size_t> children;
+        if(i + 1 < clusterEnd)
+        {
+            const std::uint64_t count = random(0, 3);
+            for(std::uint64_t j = 0; j < count; ++j)
+                children.insert(random(i + 1, clusterEnd - 1));
+        }
+        if(children.empty())
+        {
+            rule += "no other bags.";
+        }
+        for(auto it = children.begin(); it != children.end(); ++it)
+        {
+            const std::uint64_t count = random(1, 5);
+            rule += std::to_string(count) + ' ' + names[*it] + (count == 1 ? " bag" : " bags");
+            rule += std::next(it) == children.end() ? "." : ", ";
+        }
+        rules.push_back(std::move(rule));
+    }
+    random.shuffle(rules);
+
+    std::string output;
+    for(const std::string& rule : rules)
+    {
+        output += rule;
+        output += '\n';
+    }
+    return output;
+}
+
+std::string generateDay8(std::size_t size, std::uint64_t seed)
+{
+    // Only forward jumps and nop offsets until the last instruction jumps back to the
+    // start, so the program loops and flipping that last jump is the only repair.
+    Random random{seed};
+    size = std::max<std::size_t>(size, 2);
+    auto signedValue = [](std::int64_t value)
+    {
+        return (value < 0 ? "-" : "+") + std::to_string(value < 0 ? -value : value);
+    };
+
+    std::string output;
+    for(std::size_t i = 0; i + 1 < size; ++i)
+    {
+        const std::uint64_t kind = random(0, 9);
+        if(kind < 5)
+            output += "acc " + signedValue(static_cast<std::int64_t>(random(0, 70)) - 20);
+        else
+            output += (kind < 7 ? "nop " : "jmp ") + signedValue(static_cast<std::int64_t>(random(1, std::min<std::uint64_t>(8, size - 1 - i))));
+        output += '\n';
+    }
+    output += "jmp " + signedValue(-static_cast<std::int64_t>(size - 1)) + '\n';
+    return output;
+}
+
+std::string generateDay9(std::size_t size, std::uint64_t seed)
+{
+    // Preamble of 25. Every later number is the sum of two of the previous 25; a zero is
+    // repeated often enough to stay in the window, so sums that would grow too large can
+    // fall back to x + 0. The last number is the sum of a contiguous run but of no pair.
+    // The TAIL numbers before it repeat the largest number M of their window (M + 0), so
+    // when no random run qualifies the tail itself does: at least 3M, past every pair sum.
+    constexpr std::size_t PREAMBLE = 25;
+    constexpr std::size_t TAIL = 4;
+    constexpr std::uint64_t LIMIT = std::uint64_t{1} << 40;
+    Random random{seed};
+    size = std::max(size, PREAMBLE + TAIL + 1);
+
+    std::vector<std::uint64_t> numbers;
+    numbers.reserve(size);
+    std::size_t lastZero = 0;
+    std::uint64_t tailValue = 0;
+    for(std::size_t i = 0; i + 1 < size; ++i)
+    {
+        if(i == 0 || i - lastZero == PREAMBLE - 1)
+        {
+            numbers.push_back(0);
+            lastZero = i;
+        }
+        else if(i < PREAMBLE)
+        {
+            numbers.push_back(random(1, 1u << 20));
+        }
+        else if(i + TAIL + 1 >= size)
+        {
+            if(tailValue == 0)
+                tailValue = *std::max_element(numbers.end() - PREAMBLE, numbers.end());
+            numbers.push_back(tailValue);
+        }
+        else
+        {
+            std::uint64_t a = numbers[i - random(1, PREAMBLE)];
+            std::uint64_t b = numbers[i - random(1, PREAMBLE)];
+            numbers.push_back(a + b <= LIMIT ? a + b : a);
+        }
+    }
+
+    std::set<std::uint64_t> pairSums;
+    for(std::size_t i = numbers.size() - PREAMBLE; i < numbers.size(); ++i)
+        for(std::size_t j = i; j < numbers.size(); ++j)
+            pairSums.insert(numbers[i] + numbers[j]);
+
+    std::size_t begin = random(0, numbers.size() - 2);
+    std::uint64_t invalid = numbers[begin];
+    std::size_t end = begin + 1;
+    for(; end < numbers.size() && (end - begin < 2 || pairSums.count(invalid) > 0); ++end)
+        invalid += numbers[end];
+    if(pairSums.count(invalid) > 0)
+        invalid = std::accumulate(numbers.end() - TAIL, numbers.end(), std::uint64_t{0});
+    assert(pairSums.count(invalid) == 0);
+    numbers.push_back(invalid);
+
+    std::string output;
+    for(std::uint64_t number : numbers)
+        appendLine(output, number);
+    return output;
+}
+
+std::string generateDay10(std::size_t size, std::uint64_t seed)
+{
+    // Runs of 1 jolt steps are at most 4 long, as in the puzzle. A run of k steps multiplies
+    // the part 2 arrangement count by WAYS[k], and runs stop growing before that count
+    // would pass LIMIT, so it stays exact in 64 bits at any size.
+    constexpr std::uint64_t WAYS[] = {1, 1, 2, 4, 7};
+    constexpr std::size_t MAX_RUN = std::size(WAYS) - 1;
+    constexpr std::uint64_t LIMIT = std::uint64_t{1} << 60;
+    Random random{seed};
+    std::vector<std::uint64_t> adapters;
+    adapters.reserve(size);
+    std::uint64_t jolt = 0;
+    std::uint64_t arrangements = 1;     // of the runs already ended by a 3 jolt step
+    std::size_t run = 0;
+    for(std::size_t i = 0; i < size; ++i)
+    {
+        const bool one = random.chance(70) && run < MAX_RUN && arrangements <= LIMIT / WAYS[run + 1];
+        if(one)
+        {
+            ++run;
+        }
+        else
+        {
+            arrangements *= WAYS[run];
+            run = 0;
+        }
+        jolt += one ? 1 : 3;
+        adapters.push_back(jolt);
+    }
+    random.shuffle(adapters);
+
+    std::string output;
+    for(std::uint64_t adapter : adapters)
+        appendLine(output, adapter);
+    return output;
+}
+
+std::string generateDay11(std::size_t size, std::uint64_t seed)
+{
+    return generateGrid(size, size, 'L', '.', 75, seed);
+}
+
+std::string generateDay12(std::size_t size, std::uint64_t seed)
+{
+    static const std::array<char, 5> MOVES = {'N', 'S', 'E', 'W', 'F'};
+    Random random{seed};
+    std::string output;
+    for(std::size_t i = 0; i < size; ++i)
+    {
+        if(random.chance(20))
+        {
+            output += random.chance(50) ? 'L' : 'R';
+            output += std::to_string(90 * random(1, 3));
+        }
+        else
+        {
+            output += random.pick(MOVES);
+            output += std::to_string(random(1, 100));
+        }
+        output += '\n';
+    }
+    return output;
+}
+
+std::string generateDay13(std::size_t size, std::uint64_t seed)
+{
+    // distinct primes, so the schedule keeps the puzzle's coprime property
+    Random random{seed};
+    size = std::max<std::size_t>(size, 1);
+    std::vector<std::uint64_t> primes;
+    for(std::uint64_t candidate = 11; primes.size() < size; ++candidate)
+    {
+        bool isPrime = true;
+        for(std::uint64_t prime : primes)
+        {
+            if(prime * prime > candidate)
+                break;
+            if(candidate % prime == 0)
+            {
+                isPrime = false;
+                break;
+            }
+        }
+        for(std::uint64_t small : {2, 3, 5, 7})
+            isPrime &= candidate % small != 0;
+        if(isPrime)
+            primes.push_back(candidate);
+    }
+    random.shuffle(primes);
+
+    std::string output = std::to_string(random(100000, 10000000)) + '\n';
+    std::size_t nextPrime = 0;
+    for(std::size_t i = 0; i < size; ++i)
+    {
+        if(i > 0)
+            output += ',';
+        output += i == 0 || random.chance(25) ? std::to_string(primes[nextPrime++]) : "x";
+    }
+    output += '\n';
+    return output;
+}
+
+std::string generateDay14(std::size_t size, std::uint64_t seed)
+{
+    // at most 9 floating bits per mask, which bounds part2 to 512 writes per mem line
+    Random random{seed};
+    std::string output;
+    for(std::size_t line = 0; line < size;)
+    {
+        std::string mask(36, '0');
+        for(char& bit : mask)
+            bit = random.chance(50) ? '1' : '0';
+        const std::uint64_t floating = random(0, 9);
+        for(std::uint64_t i = 0; i < floating; ++i)
+            mask[random(0, 35)] = 'X';
+        output += "mask = " + mask + '\n';
+        ++line;
+
+        const std::uint64_t writes = random(1, 8);
+        for(std::uint64_t i = 0; i < writes && line < size; ++i, ++line)
+        {
+            output += "mem[" + std::to_string(random(0, 65535)) + "] = " + std::to_string(random(0, 1u << 30)) + '\n';
+        }
+    }
+    return output;
+}
+
+std::string generateDay15(std::size_t size, std::uint64_t seed)
+{
+    Random random{seed};
+    std::vector<std::uint64_t> numbers;
+    for(std::uint64_t i = 0; i < std::max<std::size_t>(size, 1); ++i)
+        numbers.push_back(i);
+    random.shuffle(numbers);
+
+    std::string output;
+    for(std::size_t i = 0; i < numbers.size(); ++i)
+    {
+        if(i > 0)
+            output += ',';
+        output += std::to_string(numbers[i]);
+    }
+    output += '\n';
+    return output;
+}
+
+std::string generateDay16(std::size_t size, std::uint64_t seed)
+{
+    // The field of rank r accepts 1..limit[r] with limits shrinking by rank, and every
+    // column holds a value only its own field and the lower ranks accept, so the columns
+    // have nested candidate sets and the elimination in part2 always resolves.
+    static const std::array<const char*, 20> NAMES = {
+        "departure location", "departure station", "departure platform", "departure track", "departure date",
+        "departure time", "arrival location", "arrival station", "arrival platform", "arrival track",
+        "class", "duration", "price", "route", "row", "seat", "train", "type", "wagon", "zone"};
+    constexpr std::size_t FIELDS = NAMES.size();
+    Random random{seed};
+
+    std::vector<std::size_t> rankOfField(FIELDS);
+    for(std::size_t i = 0; i < FIELDS; ++i)
+        rankOfField[i] = i;
+    random.shuffle(rankOfField);
+    std::vector<std::size_t> fieldOfColumn(FIELDS);
+    for(std::size_t i = 0; i < FIELDS; ++i)
+        fieldOfColumn[i] = i;
+    random.shuffle(fieldOfColumn);
+
+    auto limit = [](std::size_t rank) { return static_cast<std::uint64_t>(100 + 40 * (FIELDS - rank)); };
+    const std::uint64_t maxValid = limit(0);
+
+    std::string output;
+    for(std::size_t field = 0; field < FIELDS; ++field)
+    {
+        const std::uint64_t max = limit(rankOfField[field]);
+        const std::uint64_t split = random(2, max - 1);
+        output += std::string{NAMES[field]} + ": 1-" + std::to_string(split) + " or " + std::to_string(split + 1) + '-' + std::to_string(max) + '\n';
+    }
+
+    auto ticket = [&](bool own, bool invalid)
+    {
+        std::string line;
+        const std::size_t invalidColumn = random(0, FIELDS - 1);
+        for(std::size_t column = 0; column < FIELDS; ++column)
+        {
+            const std::size_t rank = rankOfField[fieldOfColumn[column]];
+            std::uint64_t value = random(1, limit(rank));
+            if(own && rank + 1 < FIELDS)
+                value = random(limit(rank + 1) + 1, limit(rank));
+            if(invalid && column == invalidColumn)
+                value = maxValid + random(1, 100);
+            if(column > 0)
+                line += ',';
+            line += std::to_string(value);
+        }
+        return line + '\n';
+    };
+
+    output += "\nyour ticket:\n" + ticket(true, false);
+    output += "\nnearby tickets:\n";
+    for(std::size_t i = 0; i < size; ++i)
+        output += ticket(false, random.chance(25));
+    return output;
+}
+
+std::string generateDay17(std::size_t size, std::uint64_t seed)
+{
+    return generateGrid(size, size, '#', '.', 40, seed);
+}
+
+std::string generateDay18(std::size_t size, std::uint64_t seed)
+{
+    Random random{seed};
+    std::string output;
+    auto expression = [&random](auto& self, int depth) -> std::string
+    {
+        std::string result;
+        const std::uint64_t operands = random(2, 6);
+        for(std::uint64_t i = 0; i < operands; ++i)
+        {
+            if(i > 0)
+                result += random.chance(50) ? " + " : " * ";
+            if(depth < 3 && random.chance(20))
+                result += '(' + self(self, depth + 1) + ')';
+            else
+                result += static_cast<char>('0' + random(1, 9));
+        }
+        return result;
+    };
+    for(std::size_t i = 0; i < size; ++i)
+    {
+        output += expression(expression, 0);
+        output += '\n';
+    }
+    return output;
+}
+
+}
+
+const std::vector<DayGenerator>& getGenerators()
+{
+    static const std::vector<DayGenerator> generators{
+        {1, "expense entries", generateDay1},
+        {2, "password lines", generateDay2},
+        {3, "map rows (31 columns)", generateDay3},
+        {4, "passports", generateDay4},
+        {5, "boarding passes", generateDay5},
+        {6, "groups", generateDay6},
+        {7, "bag rules", generateDay7},
+        {8, "instructions", generateDay8},
+        {9, "numbers (preamble 25)", generateDay9},
+        {10, "adapters", generateDay10},
+        {11, "rows and columns of the seat map", generateDay11},
+        {12, "navigation instructions", generateDay12},
+        {13, "bus slots", generateDay13},
+        {14, "program lines", generateDay14},
+        {15, "starting numbers", generateDay15},
+        {16, "nearby tickets (20 fields)", generateDay16},
+        {17, "rows and columns of the initial slice", generateDay17},
+        {18, "expressions", generateDay18},
+    };
+    return generators;
+}
+
+const DayGenerator* findGenerator(int day)
+{
+    const auto& generators = getGenerators();
+    auto it = std::find_if(generators.begin(), generators.end(), [day](const DayGenerator& generator)
+    {
+        return generator.day == day;
+    });
+    return it == generators.end() ? nullptr : &*it;
+}
+
+std::string generate(int day, std::size_t size, std::uint64_t seed)
+{
+    const DayGenerator* generator = findGenerator(day);
+    return generator ? generator->generate(size, seed) : std::string{};
+}
+
+std::string generateTreeMap(std::size_t rows, std::size_t columns, std::uint64_t seed)
+{
+    std::string output = generateGrid(rows, columns, '#', '.', 25, seed);
+    if(output.empty() == false)
+    {
+        output[0] = '.';
+    }
+    return output;
+}
+
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <string>
+#include <vector>
+
+// Synthetic puzzle inputs of arbitrary size for scale testing. Every generator is
+// deterministic for a given (size, seed) and produces input the day's solvers accept.
+namespace Generator
+{
+
+using GenerateFunc = std::string(*)(std::size_t size, std::uint64_t seed);
+
+struct DayGenerator
+{
+    int day = 0;
+    const char* sizeDescription = "";   // what size means for the day
+    GenerateFunc generate = nullptr;
+};
+
+const std::vector<DayGenerator>& getGenerators();
+const DayGenerator* findGenerator(int day);
+
+std::string generate(int day, std::size_t size, std::uint64_t seed);
+
+// A day 3 map of any width; generate(3, ...) uses the 31 columns of the puzzle.
+std::string generateTreeMap(std::size_t rows, std::size_t columns, std::uint64_t seed);
+
+}
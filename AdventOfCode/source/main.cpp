@@ -1,23 +1,369 @@
-namespace Day2 { void part1(); }
-namespace Day3 { void part1(); }
-namespace Day4 { void part1(); }
-namespace Day5 { void part1(); }
-namespace Day6 { void part1(); void part2(); }
-namespace Day7 { void part1(); void part2(); }
-namespace Day8 { void part1(); void part2(); }
-namespace Day9 { void part1(); void part2(); }
-namespace Day10 { void part1(); void part2(); }
-namespace Day11 { void part1(); void part2(); }
-namespace Day12 { void part1(); void part2(); }
-namespace Day13 { void part1(); void part2(); }
-namespace Day14 { void part1(); void part2(); void solve(); }
-namespace Day15 { void part1(); void part2(); void solve(); }
-namespace Day16 { void part1(); void part2(); void solve(); }
-namespace Day17 { void part1(); void part2(); void solve(); }
-namespace Day17_part2 { void part1(); void part2(); void solve(); }
-namespace Day18 { void part1(); void part2(); void solve(); }
-
-int main()
-{
-	Day18::solve();
+#include "Common/Benchmark.hh"
+#include "Common/Registry.hh"
+#include "Common/Resources.hh"
+#include "Common/Runner.hh"
+#include "Common/ThreadPool.hh"
+#include "Common/Trace.hh"
+
+#include <cstdlib>
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+struct Selection
+{
+    bool matches(const Common::Solver& solver) const
+    {
+        return solver.day == day && (part == 0 || solver.part == part);
+    }
+
+    int day = 0;
+    int part = 0; // 0 selects every part of the day
+};
+
+void printUsage(std::ostream& stream)
+{
+    stream <<
+        "usage: aoc [--data <dir>] [--list] [--verify] [--trace <file> [--counters]] [-j <threads>] [--bench [--iterations <n>] [--warmup <n>] [--json <file>]] (--all | <day>[.<part>]...)\n"
+        "  <day>[.<part>]  run the solvers of a day, or of one part of it, e.g. 5 or 12.2\n"
+        "  --all           run every registered solver, concurrently unless -j 1 is given\n"
+        "  -j <threads>    number of solvers to run concurrently (default: 1, or " << Common::ThreadPool::getDefaultNumThreads() << " with --all)\n"
+        "  --data <dir>    directory containing PuzzleInput/ (default: " << Common::Registry::getDataDirectory().string() << ");\n"
+        "                  solvers whose input is missing from another directory are skipped\n"
+        "  --list          list the registered solvers\n"
+        "  --verify        also fail when a solver has no expected answer in its answers.txt\n"
+        "  --trace <file>  record the phase timers of the solvers, print a summary and write a Chrome\n"
+        "                  trace (needs a build with -DAOC_TRACE=ON)\n"
+        "  --counters      with --trace, also read cycles, instructions, cache and branch misses\n"
+        "  --bench         benchmark the selected solvers one after the other: median and p99 of the\n"
+        "                  whole run and of its parse and solve phases, and the throughput\n"
+        "  --iterations <n>, --warmup <n>\n"
+        "                  measured and warmup runs per solver (default: 10 and 1, fewer once a solver\n"
+        "                  has taken more than 10 s)\n"
+        "  --json <file>   also write the benchmark results as JSON, - for stdout\n";
+}
+
+bool parseSelection(const std::string& arg, Selection& selection)
+{
+    try
+    {
+        std::size_t pos = 0;
+        selection.day = std::stoi(arg, &pos);
+        if(pos < arg.size())
+        {
+            if(arg[pos] != '.')
+                return false;
+            std::size_t partPos = 0;
+            selection.part = std::stoi(arg.substr(pos + 1), &partPos);
+            if(pos + 1 + partPos != arg.size())
+                return false;
+        }
+    }
+    catch(...)
+    {
+        return false;
+    }
+    return selection.day > 0 && selection.part >= 0;
+}
+
+struct Summary
+{
+    double sumOfSeconds = 0.0;
+    std::size_t numVerified = 0;
+    std::size_t numFailed = 0;      // wrong answer or error
+    std::size_t numUnverified = 0;  // no expected answer in answers.txt
+};
+
+void report(const Common::RunResult& result, Summary& summary)
+{
+    std::cout << result << std::endl;
+    summary.sumOfSeconds += result.seconds;
+    if(result.isCorrect() == false)
+        ++summary.numFailed;
+    else if(result.expected.has_value())
+        ++summary.numVerified;
+    else
+        ++summary.numUnverified;
+}
+
+Summary runSequentially(const std::vector<const Common::Solver*>& solvers)
+{
+    Summary summary;
+    for(const Common::Solver* solver : solvers)
+    {
+        report(Common::run(*solver), summary);
+    }
+    return summary;
+}
+
+// Results are printed in registry order as soon as every earlier one is done, not in completion order.
+Summary runConcurrently(const std::vector<const Common::Solver*>& solvers, std::size_t numThreads)
+{
+    Common::ThreadPool pool{numThreads};
+    std::vector<std::future<Common::RunResult>> futures;
+    for(const Common::Solver* solver : solvers)
+    {
+        futures.push_back(pool.submit([solver]() { return Common::run(*solver, false); }));
+    }
+    Summary summary;
+    for(auto& future : futures)
+    {
+        report(future.get(), summary);
+    }
+    return summary;
+}
+
+int runBenchmarks(const std::vector<const Common::Solver*>& solvers, const Common::BenchmarkOptions& options, const std::string& jsonPath)
+{
+    std::vector<Common::BenchmarkResult> results;
+    bool allCorrect = true;
+    std::ostream& log = jsonPath == "-" ? std::cerr : std::cout;
+    for(const Common::Solver* solver : solvers)
+    {
+        results.push_back(Common::benchmark(*solver, options));
+        log << results.back() << std::endl;
+        allCorrect &= results.back().isCorrect();
+    }
+
+    if(jsonPath == "-")
+    {
+        Common::writeJson(std::cout, results);
+    }
+    else if(jsonPath.empty() == false)
+    {
+        std::ofstream file{jsonPath};
+        Common::writeJson(file, results);
+        if(!file)
+        {
+            std::cerr << "cannot write " << jsonPath << "\n";
+            return EXIT_FAILURE;
+        }
+    }
+    return allCorrect ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+int runSolvers(const std::vector<const Common::Solver*>& selected, bool all, std::size_t numThreads, bool verify)
+{
+    if(numThreads == 0)
+    {
+        numThreads = all ? Common::ThreadPool::getDefaultNumThreads() : 1;
+    }
+    Common::Stopwatch stopwatch;
+    Summary summary = numThreads > 1 ? runConcurrently(selected, numThreads) : runSequentially(selected);
+    const double makespan = stopwatch.getSeconds();
+
+    std::cout << std::fixed << std::setprecision(3)
+        << selected.size() << " runs on " << numThreads << " thread(s): makespan " << makespan * 1000.0
+        << " ms, sum of solver times " << summary.sumOfSeconds * 1000.0 << " ms";
+    if(makespan > 0.0)
+    {
+        std::cout << ", speedup " << std::setprecision(2) << summary.sumOfSeconds / makespan << "x";
+    }
+    if(numThreads > 1)
+    {
+        std::cout << ", peak memory " << std::setprecision(3) << static_cast<double>(Common::getPeakMemory()) / (1024.0 * 1024.0) << " MiB";
+    }
+    std::cout << std::endl;
+    std::cout << summary.numVerified << " answer(s) verified, " << summary.numFailed << " failed, "
+        << summary.numUnverified << " without an expected answer" << std::endl;
+    const bool failed = summary.numFailed > 0 || (verify && summary.numUnverified > 0);
+    return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+bool writeTrace(const std::string& path)
+{
+    const std::vector<Common::TraceEvent> events = Common::Tracer::instance().takeEvents();
+    std::cout << "trace summary:\n";
+    Common::Tracer::writeSummary(std::cout, events);
+    std::ofstream file{path};
+    Common::Tracer::writeChromeTrace(file, events);
+    if(!file)
+    {
+        std::cerr << "cannot write " << path << "\n";
+        return false;
+    }
+    return true;
+}
+
+}
+
+int main(int argc, char* argv[])
+{
+    std::vector<Selection> selections;
+    bool customData = false;
+    bool list = false;
+    bool all = false;
+    std::size_t numThreads = 0;
+    bool verify = false;
+    std::string tracePath;
+    bool counters = false;
+    bool bench = false;
+    Common::BenchmarkOptions benchmarkOptions;
+    std::string jsonPath;
+    for(int i = 1; i < argc; ++i)
+    {
+        const std::string arg{argv[i]};
+        Selection selection;
+        if(arg == "--data" && i + 1 < argc)
+        {
+            Common::Registry::setDataDirectory(argv[++i]);
+            customData = true;
+        }
+        else if(arg == "--list")
+        {
+            list = true;
+        }
+        else if(arg == "--all")
+        {
+            all = true;
+        }
+        else if((arg == "-j" || arg == "--jobs") && i + 1 < argc && std::atoi(argv[i + 1]) > 0)
+        {
+            numThreads = static_cast<std::size_t>(std::atoi(argv[++i]));
+        }
+        else if(arg == "--verify")
+        {
+            verify = true;
+        }
+        else if(arg == "--trace" && i + 1 < argc)
+        {
+            tracePath = argv[++i];
+        }
+        else if(arg == "--counters")
+        {
+            counters = true;
+        }
+        else if(arg == "--bench")
+        {
+            bench = true;
+        }
+        else if(arg == "--iterations" && i + 1 < argc && std::atoi(argv[i + 1]) > 0)
+        {
+            benchmarkOptions.iterations = std::atoi(argv[++i]);
+        }
+        else if(arg == "--warmup" && i + 1 < argc && std::atoi(argv[i + 1]) >= 0)
+        {
+            benchmarkOptions.warmupIterations = std::atoi(argv[++i]);
+        }
+        else if(arg == "--json" && i + 1 < argc)
+        {
+            jsonPath = argv[++i];
+        }
+        else if(arg == "--help" || arg == "-h")
+        {
+            printUsage(std::cout);
+            return EXIT_SUCCESS;
+        }
+        else if(parseSelection(arg, selection))
+        {
+            selections.push_back(selection);
+        }
+        else
+        {
+            std::cerr << "invalid argument: " << arg << "\n";
+            printUsage(std::cerr);
+            return EXIT_FAILURE;
+        }
+    }
+
+    const auto& solvers = Common::Registry::instance().getSolvers();
+    if(list)
+    {
+        for(const Common::Solver& solver : solvers)
+        {
+            std::cout << solver.getName() << "\n";
+        }
+        return EXIT_SUCCESS;
+    }
+    if(selections.empty() && all == false)
+    {
+        printUsage(std::cerr);
+        return EXIT_FAILURE;
+    }
+
+    std::vector<const Common::Solver*> selected;
+    for(const Common::Solver& solver : solvers)
+    {
+        bool isSelected = all;
+        for(const Selection& selection : selections)
+        {
+            isSelected |= selection.matches(solver);
+        }
+        if(isSelected)
+        {
+            selected.push_back(&solver);
+        }
+    }
+
+    // a typo or an unregistered day must not pass as an empty but successful run
+    bool allMatched = true;
+    for(const Selection& selection : selections)
+    {
+        const bool matched = std::any_of(solvers.begin(), solvers.end(), [&selection](const Common::Solver& solver)
+        {
+            return selection.matches(solver);
+        });
+        if(matched == false)
+        {
+            std::cerr << "no registered solver for day " << selection.day;
+            if(selection.part != 0)
+            {
+                std::cerr << " part " << selection.part;
+            }
+            std::cerr << " (see --list)\n";
+            allMatched = false;
+        }
+    }
+    if(allMatched == false)
+    {
+        return EXIT_FAILURE;
+    }
+
+    if(customData)
+    {
+        // another tree, e.g. of generated inputs, usually holds only some of the inputs
+        const auto missing = std::remove_if(selected.begin(), selected.end(), [](const Common::Solver* solver)
+        {
+            return std::filesystem::exists(solver->getInputPath()) == false;
+        });
+        if(missing != selected.end())
+        {
+            std::cerr << "note: skipping " << (selected.end() - missing) << " solver(s) without an input in "
+                << Common::Registry::getDataDirectory().string() << "\n";
+            selected.erase(missing, selected.end());
+        }
+        if(selected.empty())
+        {
+            std::cerr << "no selected solver has an input in " << Common::Registry::getDataDirectory().string() << "\n";
+            return EXIT_FAILURE;
+        }
+    }
+
+    if(tracePath.empty() == false)
+    {
+#if AOC_TRACE
+        if(Common::Tracer::instance().enable(counters) == false)
+        {
+            std::cerr << "note: hardware counters are not available (see /proc/sys/kernel/perf_event_paranoid)\n";
+        }
+#else
+        std::cerr << "--trace needs a build with -DAOC_TRACE=ON, which compiles the trace scopes in\n";
+        return EXIT_FAILURE;
+#endif
+    }
+    const int exitCode = bench ? runBenchmarks(selected, benchmarkOptions, jsonPath) : runSolvers(selected, all, numThreads, verify);
+    if(tracePath.empty() == false && writeTrace(tracePath) == false)
+    {
+        return EXIT_FAILURE;
+    }
+    return exitCode;
 }